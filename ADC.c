@@ -9,33 +9,79 @@
 #include "MCUType.h"
 #include "app_cfg.h"
 #include "os.h"
+#include "Hal.h"
 #include "K65TWR_GPIO.h"
+#include "DspArena.h"
+#include "Window.h"
+#include "Timebase.h"
+#include "Note.h"
+#include "Analyzer.h"
 #include "ADC.h"
-
-#define SAMPLE_RATE 44100       //Rate in Hz that ADC samples at
-#define AVERAGING_PER 100       //Time in ms between frequency calculations
-
-#define SAMPLES 2048            //1024 real parts and 1024 imaginary parts. Creates frequency resolution of 44100/1024 = 43Hz
-#define FFT_SIZE SAMPLES/2      //FFT size is number of real samples
-
-#define FREQ_AVG_SIZE 20        //Number of frequency calculations to take an average of for note output (1 = no averaging)
-
-//Offset and gain errors from frequency calculations (found experimentally)
-#define OFFSET_ERR 0                    //Measured frequency at ~0Hz accurate
-#define GAIN_ERR (30 + OFFSET_ERR)      //Measured frequency at 20kHz is 30Hz too high
-
-FP32 Input[SAMPLES];
-FP32 Output[FFT_SIZE];
+#include "Sweep.h"
+#include "Profile.h"
+#include "Loopback.h"
+
+//ADC conversion timing, K65 reference manual ADC chapter. All in ADCK cycles except SFC_BUS
+#define ADC_SFC_ADCK 3u         //Single conversion adder, ADCK part
+#define ADC_SFC_BUS 5u          //Single conversion adder, bus clock part
+#define ADC_MODE_8BIT 0u        //ADC_CFG1 MODE encodings
+#define ADC_MODE_12BIT 1u
+#define ADC_MODE_10BIT 2u
+#define ADC_MODE_16BIT 3u
+
+#define FFT_SIZE DSP_FFT_SIZE   //FFT size is number of real samples
+#define HOP_SIZE ANA_HOP_SIZE   //Samples per hop, one analyzer frame each
+
+//Capture FIFO between ADC0_IRQHandler() and ADCTask. Holds whole hops, a power of 2 of them.
+//A conversion that finds it full is dropped and counted.
+#define ADC_FIFO_HOPS 4u
+#define ADC_FIFO_SIZE (ADC_FIFO_HOPS*HOP_SIZE)
+#define ADC_HOP_TIMEOUT 50u     //OS ticks. No hop this long means the loopback took over
+
+//Acquisition profile. Programs ADC0_CFG1/CFG2/SC3 and the PIT1 trigger rate
+typedef struct{
+    INT8U adiv;         //ADCK = bus clock/2^adiv
+    INT8U mode;         //ADC_MODE_xBIT
+    INT8U lsmp;         //1 = long sample time
+    INT8U lsts;         //Long sample time select, 0 = +20, 1 = +12, 2 = +6, 3 = +2 ADCK
+    INT8U avg_n;        //Hardware averaging, 1 (off), 4, 8, 16 or 32 conversions
+    INT32U rate;        //Requested sample rate in Hz
+} ADC_PROFILE;
+
+static const ADC_PROFILE adcProfiles[ADC_PROF_NUM] = {
+    {3u, ADC_MODE_16BIT, 1u, 0u, 1u, 44100u},      //ADC_PROF_16BIT_LONG      6.4us
+    {3u, ADC_MODE_16BIT, 1u, 2u, 4u, 44100u},      //ADC_PROF_16BIT_AVG4      17.0us
+    {2u, ADC_MODE_12BIT, 0u, 0u, 8u, 44100u},      //ADC_PROF_12BIT_AVG8      10.9us
+    {3u, ADC_MODE_16BIT, 1u, 0u, 32u, 44100u},     //ADC_PROF_16BIT_AVG32     192us, refused
+};
+
+static const INT8U adcLstAdder[4] = {20u, 12u, 6u, 2u};    //Long sample ADCK cycles by ADLSTS
+static const INT8U adcModeBits[4] = {8u, 12u, 10u, 16u};    //Result width by ADC_MODE_xBIT
 
 static void ADCTask(void *p_arg);
+static INT8U ADCProfileApply(INT8U prof);
+static void ADCNoteEvent(void *arg, const NOTE *note);
+static void ADCFifoFlush(void);
 
 //Private resources
 static OS_TCB adcTaskTCB;                               //Allocate ADC Task control block
 static CPU_STK adcTaskStk[APP_CFG_ADC_TASK_STK_SIZE];   //Allocate ADC Task stack space
 static OS_SEM NoteChgFlag;
+static OS_SEM adcHopRdy;                                //Posted for each hop in the FIFO
 
-static INT32U adcFreq[FREQ_AVG_SIZE] = {0};             //Frequencies calculated from ADC's readings
+static INT16U adcFifo[ADC_FIFO_SIZE];
+static volatile INT32U adcFifoWr = 0;                   //Free running, ADC0_IRQHandler() only
+static volatile INT32U adcFifoRd = 0;                   //Free running, ADCTask only
+static INT32U adcHopStamp[ADC_FIFO_HOPS];               //CYCCNT at the last sample of each hop
+static INT32U adcEventStamp;                            //Stamp of the hop being analyzed
+static ADC_STREAM_STATS adcStream;
+static INT64U adcLatSum;                                //Cycles, for lat_mean_us
+
+static ANALYZER adcAnalyzer;                            //Pitch analyzer fed by ADCTask
 static NOTE noteOut;
+static INT8U adcWindow = WIN_HANN;                      //Window applied during capture
+static INT8U adcProfile;                                //Profile currently programmed
+static volatile INT8U adcProfileReq;                    //Profile requested by ADCProfileSet()
 
 /*****************************************************************************************
 * ADCInit() - Initializes the ADC peripheral
@@ -44,33 +90,40 @@ static NOTE noteOut;
 void ADCInit(){
     OS_ERR os_err;
 
-    //Enable PIT1
-    SIM_SCGC6 |= SIM_SCGC6_PIT_MASK;        //Start SCGC6 clock for PIT
-    PIT_MCR &= ~PIT_MCR_MDIS_MASK;          //Enable PIT via MCR
-    PIT_LDVAL1 = 60000000/SAMPLE_RATE;      //Set PIT1 sample rate (Bus Clock = 60MHz)
-    PIT_TCTRL1 |= PIT_TCTRL_TEN_MASK;       //Enable timer
-    PIT_TCTRL1 |= PIT_TCTRL_TIE_MASK;       //Enable timer interrupt
+    //Enable PIT1, the timer itself is started by the acquisition profile
+    HalGateSet(HAL_SCGC6, SIM_SCGC6_PIT_MASK);  //Start SCGC6 clock for PIT
+    HalPitEnable();                             //Enable PIT via MCR
+    HalPitIrqEnable(TB_PIT_ADC);                //Enable timer interrupt
 
     //Enable ADC0
-    SIM_SCGC6 |= SIM_SCGC6_ADC0(1);         //Start SCGC6 clock for ADC0
-    ADC0_CFG1 |= ADC_CFG1_ADIV(3);          //Divide bus clock by 8
-    ADC0_CFG1 |= ADC_CFG1_MODE(3);          //Set to 16 bit samples
-    ADC0_CFG1 |= ADC_CFG1_ADLSMP(1);        //Set to long samples
-    ADC0_SC2 |= ADC_SC2_ADTRG(1);           //Set ADC0 for hardware trigger
-    ADC0_SC3 |= ADC_SC3_AVGE(1);            //Enable hardware averager
-    ADC0_SC3 |= ADC_SC3_AVGS(3);            //Set hardware averager to 32 samples
-    SIM_SOPT7 |= SIM_SOPT7_ADC0TRGSEL(5);   //Set PIT1 as hardware trigger
-    SIM_SOPT7 |= SIM_SOPT7_ADC0ALTTRGEN(1); //Set ADC0 to have alternate trigger
-
-    PIT_TFLG1 |= PIT_TFLG_TIF_MASK;         //Reset PIT1 interrupt flag
-    NVIC_ClearPendingIRQ(PIT1_IRQn);        //Clear PIT1 pending interrupts
+    HalGateSet(HAL_SCGC6, SIM_SCGC6_ADC0(1));   //Start SCGC6 clock for ADC0
+    HalAdcTrigSet(SIM_SOPT7_ADC0TRGSEL(5));     //Set PIT1 as hardware trigger
+    HalAdcTrigSet(SIM_SOPT7_ADC0ALTTRGEN(1));   //Set ADC0 to have alternate trigger
 
-    ADC0_SC1A = ADC_SC1_ADCH(3);            //Set input to DADP3
+    HalPitFlagClear(TB_PIT_ADC);                //Reset PIT1 interrupt flag
+    HalIrqPendClear(PIT1_IRQn);        //Clear PIT1 pending interrupts
 
+    //Calibrate in software trigger mode with 32x averaging. SC3 is written whole here,
+    //so the profile's averaging has to be programmed after calibration.
+    HalAdcCfg1Set(ADC_CFG1_ADIV(3) | ADC_CFG1_MODE(ADC_MODE_16BIT) | ADC_CFG1_ADLSMP(1));
+    HalAdcSc2Set(0);
     do{
-        ADC0_SC3 = ADC_SC3_CAL(1);                  //Begin calibration
-        while((ADC0_SC3 & ADC_SC3_CAL(1)) == 1){}   //Wait for calibration
-    } while((ADC0_SC3 & ADC_SC3_CALF(1)) == 1);     //Repeat if failed
+        HalAdcSc3Set(ADC_SC3_CAL(1) | ADC_SC3_AVGE(1) | ADC_SC3_AVGS(3));   //Begin calibration
+        while((HalAdcSc3Get() & ADC_SC3_CAL_MASK) != 0){}                   //Wait for calibration
+    } while((HalAdcSc3Get() & ADC_SC3_CALF_MASK) != 0);                     //Repeat if failed
+
+    //Program the default profile, which also starts PIT1
+    adcProfileReq = ADC_PROF_DEFAULT;
+    while(ADCProfileApply(ADC_PROF_DEFAULT) == FALSE){}     //Error Trap, profile overruns
+    HalAdcSc2Set(ADC_SC2_ADTRG(1));         //Set ADC0 for hardware trigger
+
+    //Every conversion interrupts and goes into the capture FIFO
+    OSSemCreate(&adcHopRdy, "ADC Hop Ready", 0, &os_err);
+    while(os_err != OS_ERR_NONE){}                  //Error Trap
+    ADCStreamStatsReset();
+    HalAdcChanSet(ADC_SC1_ADCH(3) | ADC_SC1_AIEN(1));   //Set input to DADP3
+    HalIrqPendClear(ADC0_IRQn);
+    HalIrqEnable(ADC0_IRQn);
 
     noteOut.note = "X";
     noteOut.oct = 255;
@@ -98,121 +151,306 @@ void ADCInit(){
 
 /*****************************************************************************************
  * ADCTask() - Controls the ADC peripheral
- * Uses ARM DSP functions to analyze incoming waveform and takes a running average of
- * results to achieve more accurate results.
+ * Takes one hop at a time from the capture FIFO, or from the loopback, and hands it to
+ * the pitch analyzer in Analyzer.c, which reports note changes through ADCNoteEvent().
  *****************************************************************************************/
 static void ADCTask(void *p_arg){
     OS_ERR os_err;
     (void)p_arg;
-    NOTE note_prev = noteOut;
-    INT8U conv_cnt = 0;
-    INT8U n = 0;
-    INT16U dummy_freq = 0;
-
-    arm_cfft_radix4_instance_f32 S;     //ARM CFFT module
-    FP32 maxValue;                      //Max FFT value is stored here
-    INT32U maxIndex;                    //Index in Output array where max value is
+    TB_RATE fs;                         //Achieved sample rate of the current profile
+    INT16U *Stage;                      //One hop of loopback samples
+    const INT16U *hop;                  //Hop being analyzed
+    INT32U frames;
+    INT32U backlog;
+    INT8U from_loop = FALSE;            //Hops come from the loopback
+
+    //The wavetable is built by now and the analyzer keeps its scratch for
+    //good, so the arena is reset and carved up once
+    fs = TimebaseRateGet(TB_PIT_ADC);
+    DspArenaReset();
+    AnalyzerInit(&adcAnalyzer, DspArenaAlloc(ANA_SCRATCH_BYTES), fs.num, fs.den,
+                 ADCNoteEvent, (void *)0);
+    Stage = DspArenaAlloc(HOP_SIZE*sizeof(INT16U));
 
     while(1){
-        for (INT16U i = 0; i < SAMPLES; i = i + 2) {
-            while((ADC0_SC1A & ADC_SC1_COCO_MASK) == 0){}
-            Input[(INT16U)i] = (FP32)ADC0_RA;   //Real part
-            Input[(INT16U)(i + 1)] = 0;         //Imaginary part
-        }
-
-        //Initialize the CFFT/CIFFT module, intFlag = 0, doBitReverse = 1
-        arm_cfft_radix4_init_f32(&S, FFT_SIZE, 0, 1);
-        //Process the data through the CFFT/CIFFT module
-        arm_cfft_radix4_f32(&S, Input);
-        //Process the data through the Complex Magniture Module for calculating the magnitude at each bin
-        arm_cmplx_mag_f32(Input, Output, FFT_SIZE);
-
-        //Zero out results that contain useless information
-        Output[0] = 0;
-        for(int j = FFT_SIZE/2; j < FFT_SIZE; j++){
-            Output[j] = 0;
+        //A new profile can change the resolution, so nothing captured before it is
+        //analyzed with anything after it
+        if(adcProfileReq != adcProfile){
+            (void)ADCProfileApply(adcProfileReq);
+            ADCFifoFlush();
+            AnalyzerFlush(&adcAnalyzer);
+        } else{}
+        //So is a switch between ADC0 and the loopback
+        if(LoopbackActive() != from_loop){
+            from_loop = LoopbackActive();
+            ADCFifoFlush();
+            AnalyzerFlush(&adcAnalyzer);
+        } else{}
+        fs = TimebaseRateGet(TB_PIT_ADC);
+        AnalyzerRateSet(&adcAnalyzer, fs.num, fs.den);
+        AnalyzerWindowSet(&adcAnalyzer, adcWindow);
+        //A hop is released once its last sample is in, and has to be done before the
+        //next hop is
+        ProfileDeadlineSet(PROF_ADC, (INT32U)(((INT64U)TB_CORE_CLOCK*HOP_SIZE*fs.den)/fs.num));
+
+        //The loopback stands in for ADC0 when it is on
+        if(from_loop != FALSE){
+            LoopbackCapture(Stage, HOP_SIZE, fs, adcModeBits[adcProfiles[adcProfile].mode]);
+            adcEventStamp = HalCycleCount();
+            hop = Stage;
+        } else{
+            OSSemPend(&adcHopRdy, ADC_HOP_TIMEOUT, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+            if(os_err == OS_ERR_TIMEOUT){
+                hop = (INT16U *)0;              //Go round and check the loopback again
+            } else{
+                while(os_err != OS_ERR_NONE){}  //Error Trap
+                backlog = adcFifoWr - adcFifoRd;
+                if(backlog > adcStream.fifo_max){
+                    adcStream.fifo_max = backlog;
+                } else{}
+                adcEventStamp = adcHopStamp[(adcFifoRd/HOP_SIZE) & (ADC_FIFO_HOPS - 1u)];
+                hop = &adcFifo[adcFifoRd & (ADC_FIFO_SIZE - 1u)];
+            }
         }
 
-        //Finds max magnitude in output spectrum with corresponding index
-        arm_max_f32(Output, FFT_SIZE, &maxValue, &maxIndex);
-
-        //Calculate frequency from location of max magnitude
-        adcFreq[conv_cnt] = (SAMPLE_RATE*10000/(FFT_SIZE*10000/maxIndex));
-        conv_cnt++;
+        if(hop != (INT16U *)0){
+            ProfileBegin(PROF_ADC);
+            frames = AnalyzerFrames(&adcAnalyzer);
+            AnalyzerPush(&adcAnalyzer, hop, HOP_SIZE);
+            if(hop != Stage){
+                adcFifoRd = adcFifoRd + HOP_SIZE;   //The analyzer has its own copy now
+            } else{}
+            adcStream.hops++;
 
-        //Take average of frequency samples
-        if(conv_cnt == FREQ_AVG_SIZE){
-            noteOut.freq = 0;
-            for(INT8U j = 0; j < FREQ_AVG_SIZE; j++){
-                noteOut.freq = noteOut.freq + adcFreq[j];
-            }
-            noteOut.freq = noteOut.freq/FREQ_AVG_SIZE;
-            conv_cnt = 0;
-
-            //Adjust measured frequency for offset and gain errors
-            noteOut.freq = noteOut.freq - OFFSET_ERR;
-            noteOut.freq = (noteOut.freq*20000)/(20000 + GAIN_ERR - OFFSET_ERR);
-
-            //Find note and octave of measured frequency
-            //Find n in freq/2^n <= 31.87, where largest n = octave
-            //0th octave ends at 31.87Hz
-            //Multiply by 100Hz for 2 decimal points of precision
-            while(((noteOut.freq*100)/(1<<n)) > 3187){
-                n++;
-            }
-            noteOut.oct = n;
-            n = 0;
-
-            //Find note from frequency downshifted to 0th octave
-            //Multiply by 100Hz for 2 decimal points of precision
-            dummy_freq = (noteOut.freq*100)/(1<<noteOut.oct);
-            if(dummy_freq < 1683){
-                noteOut.note = "C";
-            } else if((dummy_freq >= 1638) && (dummy_freq < 1783)){
-                noteOut.note = "C#";
-            } else if((dummy_freq >= 1783) && (dummy_freq < 1890)){
-                noteOut.note = "D";
-            } else if((dummy_freq >= 1890) && (dummy_freq < 2002)){
-                noteOut.note = "D#";
-            } else if((dummy_freq >= 2002) && (dummy_freq < 2121)){
-                noteOut.note = "E";
-            } else if((dummy_freq >= 2121) && (dummy_freq < 2247)){
-                noteOut.note = "F";
-            } else if((dummy_freq >= 2247) && (dummy_freq < 2381)){
-                noteOut.note = "F#";
-            } else if((dummy_freq >= 2381) && (dummy_freq < 2523)){
-                noteOut.note = "G";
-            } else if((dummy_freq >= 2523) && (dummy_freq < 2673)){
-                noteOut.note = "G#";
-            } else if((dummy_freq >= 2673) && (dummy_freq < 2832)){
-                noteOut.note = "A";
-            } else if((dummy_freq >= 2673) && (dummy_freq < 3000)){
-                noteOut.note = "A#";
-            } else if((dummy_freq >= 3000) && (dummy_freq <= 3178)){
-                noteOut.note = "B";
+            //A running sweep counts independent frames, so it only sees the ones that do
+            //not overlap, before averaging and correction
+            if((AnalyzerFrames(&adcAnalyzer) != frames) &&
+               ((AnalyzerFrames(&adcAnalyzer) % (FFT_SIZE/HOP_SIZE)) == 0)){
+                SweepFrame(AnalyzerFrameHz(&adcAnalyzer), AnalyzerBinHz(&adcAnalyzer));
             } else{}
+            ProfileEnd(PROF_ADC);
         } else{}
+    }
+}
 
-        //If note structure updated, set flag
-        if((*noteOut.note != *note_prev.note)
-            || (noteOut.oct != note_prev.oct)
-            || (noteOut.freq != note_prev.freq)){
-            OSSemPost(&NoteChgFlag, OS_OPT_POST_1, &os_err);
-            while(os_err != OS_ERR_NONE){}          //Error Trap
+/*****************************************************************************************
+ * ADC0_IRQHandler() - One conversion done. Reading R[0] clears COCO. The sample goes into
+ * the capture FIFO, and each completed hop is stamped and posted to ADCTask. While the
+ * loopback is on conversions are thrown away.
+ *****************************************************************************************/
+void ADC0_IRQHandler(void){
+    OS_ERR os_err;
+    INT16U sample = (INT16U)HalAdcResult();
+    INT32U wr = adcFifoWr;
+
+    if(LoopbackActive() != FALSE){
+        //ADCTask takes its hops from the loopback
+    } else if((wr - adcFifoRd) >= ADC_FIFO_SIZE){
+        adcStream.drops++;                      //ADCTask is a whole FIFO behind
+    } else{
+        adcFifo[wr & (ADC_FIFO_SIZE - 1u)] = sample;
+        wr++;
+        adcFifoWr = wr;
+        if((wr & (HOP_SIZE - 1u)) == 0){
+            adcHopStamp[((wr/HOP_SIZE) - 1u) & (ADC_FIFO_HOPS - 1u)] = HalCycleCount();
+            ProfileRelease(PROF_ADC);
+            (void)OSSemPost(&adcHopRdy, OS_OPT_POST_1, &os_err);
+            while(os_err != OS_ERR_NONE){}      //Error Trap
         } else{}
-        note_prev = noteOut;
     }
 }
 
+/*****************************************************************************************
+ * ADCNoteEvent() - Analyzer callback, runs in ADCTask when the note changes. Publishes
+ * the note for NotePend() and records the latency from the last sample of the hop.
+ *****************************************************************************************/
+static void ADCNoteEvent(void *arg, const NOTE *note){
+    OS_ERR os_err;
+    INT32U lat = HalCycleCount() - adcEventStamp;
+    (void)arg;
+
+    noteOut = *note;
+    OSSemPost(&NoteChgFlag, OS_OPT_POST_1, &os_err);
+    while(os_err != OS_ERR_NONE){}          //Error Trap
+
+    adcStream.events++;
+    adcStream.lat_last_us = lat/(TB_CORE_CLOCK/1000000u);
+    if(adcStream.lat_last_us > adcStream.lat_max_us){
+        adcStream.lat_max_us = adcStream.lat_last_us;
+    } else{}
+    adcLatSum = adcLatSum + lat;
+    adcStream.lat_mean_us = (INT32U)((adcLatSum/adcStream.events)/(TB_CORE_CLOCK/1000000u));
+}
+
+/*****************************************************************************************
+ * ADCFifoFlush() - Throws away everything in the capture FIFO. The indexes restart at 0
+ * so hops stay aligned to the FIFO.
+ *****************************************************************************************/
+static void ADCFifoFlush(void){
+    OS_ERR os_err;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    adcFifoWr = 0;
+    adcFifoRd = 0;
+    ProfileReleaseFlush(PROF_ADC);          //The hops they were for are gone
+    CPU_CRITICAL_EXIT();
+    (void)OSSemSet(&adcHopRdy, 0, &os_err);
+    while(os_err != OS_ERR_NONE){}          //Error Trap
+}
+
+/*****************************************************************************************
+ * ADCStreamStatsGet() - Copies the capture and note event figures to *stats
+ *****************************************************************************************/
+void ADCStreamStatsGet(ADC_STREAM_STATS *stats){
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    *stats = adcStream;
+    CPU_CRITICAL_EXIT();
+}
+
+/*****************************************************************************************
+ * ADCStreamStatsReset() - Clears the capture and note event figures
+ *****************************************************************************************/
+void ADCStreamStatsReset(void){
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    adcStream.hops = 0;
+    adcStream.drops = 0;
+    adcStream.fifo_max = 0;
+    adcStream.events = 0;
+    adcStream.lat_last_us = 0;
+    adcStream.lat_max_us = 0;
+    adcStream.lat_mean_us = 0;
+    adcLatSum = 0;
+    CPU_CRITICAL_EXIT();
+}
+
+/*****************************************************************************************
+ * ADCConvTimeNs() - Calculates the time in ns that one (averaged) conversion takes with
+ * profile 'prof'. ADICLK is the bus clock and high speed configuration is off.
+ *   t = SFC + avg_n*(BCT + LSTAdder)
+ *****************************************************************************************/
+INT32U ADCConvTimeNs(INT8U prof){
+    const ADC_PROFILE *p = &adcProfiles[prof];
+    INT32U adck_hz = TB_BUS_CLOCK >> p->adiv;
+    INT32U bct;
+    INT32U lst;
+    INT32U adck_cycles;
+
+    //Base conversion time, single ended
+    if(p->mode == ADC_MODE_16BIT){
+        bct = 25u;
+    } else if(p->mode == ADC_MODE_8BIT){
+        bct = 17u;
+    } else{
+        bct = 20u;
+    }
+    //Long sample time adder
+    if(p->lsmp != 0){
+        lst = adcLstAdder[p->lsts];
+    } else{
+        lst = 0;
+    }
+    adck_cycles = ADC_SFC_ADCK + (p->avg_n*(bct + lst));
+
+    return (INT32U)((((INT64U)adck_cycles*1000000000u) + (adck_hz - 1u))/adck_hz)
+           + (((ADC_SFC_BUS*1000000000u) + (TB_BUS_CLOCK - 1u))/TB_BUS_CLOCK);
+}
+
+/*****************************************************************************************
+ * ADCSamplePeriodNs() - Achieved trigger period of profile 'prof' in ns
+ *****************************************************************************************/
+INT32U ADCSamplePeriodNs(INT8U prof){
+    return (INT32U)(((INT64U)(TimebasePitLoad(adcProfiles[prof].rate) + 1u)*1000000000u)/TB_BUS_CLOCK);
+}
+
+/*****************************************************************************************
+ * ADCProfileSet() - Requests acquisition profile 'prof'. Profiles whose conversion does
+ * not finish inside the sample period are refused and FALSE is returned. An accepted
+ * profile is programmed by ADCTask before its next frame.
+ *****************************************************************************************/
+INT8U ADCProfileSet(INT8U prof){
+    INT8U accepted;
+
+    if((prof < (INT8U)ADC_PROF_NUM) && (ADCConvTimeNs(prof) <= ADCSamplePeriodNs(prof))){
+        adcProfileReq = prof;
+        accepted = TRUE;
+    } else{
+        accepted = FALSE;
+    }
+    return accepted;
+}
+
+/*****************************************************************************************
+ * ADCSampleRateGet() - Returns the achieved sample rate of the current profile rounded
+ * to the nearest Hz. TimebaseRateGet(TB_PIT_ADC) gives the exact rational.
+ *****************************************************************************************/
+INT32U ADCSampleRateGet(void){
+    return TimebaseRateHz(TB_PIT_ADC);
+}
+
+/*****************************************************************************************
+ * ADCProfileApply() - Programs ADC0 and PIT1 for profile 'prof'. Returns FALSE without
+ * touching the hardware if the conversion would overrun the sample period.
+ *****************************************************************************************/
+static INT8U ADCProfileApply(INT8U prof){
+    const ADC_PROFILE *p = &adcProfiles[prof];
+    INT8U avgs;
+    INT8U applied;
+
+    if(ADCConvTimeNs(prof) > ADCSamplePeriodNs(prof)){
+        applied = FALSE;
+    } else{
+        TimebasePitStop(TB_PIT_ADC);            //Stop triggers while reconfiguring
+        HalAdcCfg1Set(ADC_CFG1_ADIV(p->adiv) | ADC_CFG1_MODE(p->mode) | ADC_CFG1_ADLSMP(p->lsmp));
+        HalAdcCfg2Set(ADC_CFG2_ADLSTS(p->lsts));
+        if(p->avg_n > 1u){
+            //AVGS = log2(avg_n) - 2
+            avgs = 0;
+            while((4u << avgs) < p->avg_n){
+                avgs++;
+            }
+            HalAdcSc3Set(ADC_SC3_AVGE(1) | ADC_SC3_AVGS(avgs));
+        } else{
+            HalAdcSc3Set(0);
+        }
+        adcProfile = prof;
+        TimebasePitStart(TB_PIT_ADC, p->rate);  //Restart triggers at the profile's rate
+        applied = TRUE;
+    }
+    return applied;
+}
+
+/*****************************************************************************************
+ * ADCWindowSet() - Selects the window applied to each capture frame. Takes effect on
+ * the next frame.
+ *****************************************************************************************/
+void ADCWindowSet(INT8U win){
+    if(win < (INT8U)WIN_NUM){
+        adcWindow = win;
+    } else{}
+}
+
 /*****************************************************************************************
  * NotePend() - Sets main module's note to ADC module's note when note updates
+ * Note events can come many times a second and the display reads far less often, so the
+ * events that piled up since the last read are dropped and only the latest note is returned.
  *****************************************************************************************/
 void NotePend(NOTE *new_note){
     OS_ERR os_err;
+    CPU_SR_ALLOC();
 
     //Wait for note to be updated
     OSSemPend(&NoteChgFlag, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
     while(os_err != OS_ERR_NONE){}      //Error Trap
 
-    *new_note = noteOut;                   //Update note for LCD screen
+    (void)OSSemSet(&NoteChgFlag, 0, &os_err);
+    while(os_err != OS_ERR_NONE){}      //Error Trap
+
+    CPU_CRITICAL_ENTER();
+    *new_note = noteOut;                   //Update note for LCD screen, ADCTask may preempt
+    CPU_CRITICAL_EXIT();
 }
@@ -6,14 +6,36 @@
 #ifndef ADC_H_
 #define ADC_H_
 
-//Note structure
+//Acquisition profiles, see adcProfiles[] in ADC.c
+typedef enum{
+    ADC_PROF_16BIT_LONG,        //16 bit, long sample, no averaging
+    ADC_PROF_16BIT_AVG4,        //16 bit, long sample +6 ADCK, 4x averaging
+    ADC_PROF_12BIT_AVG8,        //12 bit, ADCK 15MHz, 8x averaging
+    ADC_PROF_16BIT_AVG32,       //16 bit, long sample, 32x averaging. Overruns 44.1kHz
+    ADC_PROF_NUM
+} ADC_PROF_T;
+#define ADC_PROF_DEFAULT ADC_PROF_16BIT_AVG4
+
+//Capture and note event figures since the last ADCStreamStatsReset()
 typedef struct{
-    INT8C *note;
-    INT8U oct;
-    INT32U freq;
-} NOTE;
+    INT32U hops;            //Hops analyzed
+    INT32U drops;           //Conversions lost because the capture FIFO was full
+    INT32U fifo_max;        //Most samples waiting in the FIFO when ADCTask took a hop
+    INT32U events;          //Note changes
+    INT32U lat_last_us;     //Last sample of a hop to the note event it caused
+    INT32U lat_max_us;
+    INT32U lat_mean_us;
+} ADC_STREAM_STATS;
 
 void ADCInit(void);
 void NotePend(NOTE *new_note);
+void ADCWindowSet(INT8U win);       //win is a WINDOW_T from Window.h
+INT8U ADCProfileSet(INT8U prof);    //Returns FALSE if the profile overruns its sample period
+INT32U ADCConvTimeNs(INT8U prof);
+INT32U ADCSamplePeriodNs(INT8U prof);
+INT32U ADCSampleRateGet(void);
+void ADCStreamStatsGet(ADC_STREAM_STATS *stats);
+void ADCStreamStatsReset(void);
+void ADC0_IRQHandler(void);
 
 #endif
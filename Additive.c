@@ -0,0 +1,197 @@
+/********************************************************************
+* Additive.c - Additive (multi-tone) generator
+* Each partial is a Goertzel style recursive oscillator,
+*   y[n] = 2cos(w)*y[n-1] - y[n-2]
+* one multiply and one subtract per sample. Float recursions drift,
+* so every block the oscillators are re-seeded from exact 32 bit
+* phase accumulators, one per partial, like the DDS.
+*
+* agent, 10/18/2026
+********************************************************************/
+#include "MCUType.h"
+#include "app_cfg.h"
+#include "os.h"
+#include "Hal.h"
+#include "Timebase.h"
+#include "Additive.h"
+
+#define ADD_RAD_PER_LSB 1.4629180792671596e-9f     //2*pi/2^32
+#define ADD_BUDGET_PCT 50u          //Share of a block WaveTask may spend on partials
+#define ADD_BUDGET_RUNS 4u          //Timing runs, the fastest is kept
+#define ADD_DEFAULT_PARTIALS 5u
+
+typedef struct{
+    INT32U ratio;       //Q16 frequency ratio to the fundamental
+    FP32 amp;
+    INT32U phase;       //Exact phase at the start of the next block
+    FP32 coef;          //2cos(w) for this block
+    FP32 y1;            //y[n-1]
+    FP32 y2;            //y[n-2]
+} ADD_OSC;
+
+/*********************************************************************
+* Private Resources
+********************************************************************/
+static ADD_OSC addOsc[ADD_MAX_PARTIALS];
+static INT8U addCount = 0;
+static FP32 addGain = 0.0f;         //Q15 full scale over the summed amplitudes
+static ADD_BUDGET addBudget;
+
+static void addPartialSet(INT8U idx, INT32U ratio, FP32 amp, INT32U phase);
+static void addCountSet(INT8U count);
+
+/******************************************************************************
+ * AdditiveInit()
+ ******************************************************************************/
+void AdditiveInit(void){
+    addPartialSet(0, ADD_RATIO_ONE, 1.0f, 0);
+    addPartialSet(1, 2u*ADD_RATIO_ONE, 0.5f, 0);
+    addPartialSet(2, 3u*ADD_RATIO_ONE, 0.33f, 0);
+    addPartialSet(3, 4u*ADD_RATIO_ONE, 0.25f, 0);
+    addPartialSet(4, ADD_RATIO_ONE + (ADD_RATIO_ONE/100u), 0.5f, 0);
+    addCountSet(ADD_DEFAULT_PARTIALS);
+}
+
+/******************************************************************************
+ * AdditiveBlockStart() - Seeds y[-1] and y[-2] so the first sample lands one
+ *  step past the partial's phase, the same order the DDS uses, then moves
+ *  the exact phase on to the start of the next block. The gain keeps the
+ *  sum inside Q15 however the amplitudes add up.
+ ******************************************************************************/
+void AdditiveBlockStart(INT32U inc, INT16U samples){
+    ADD_OSC *osc;
+    INT32U step;
+    FP32 w;
+    FP32 sum = 0.0f;
+    INT8U k;
+
+    for(k = 0; k < addCount; k++){
+        osc = &addOsc[k];
+        step = (INT32U)(((INT64U)inc*osc->ratio) >> 16);
+        w = (FP32)step*ADD_RAD_PER_LSB;
+        osc->coef = 2.0f*arm_cos_f32(w);
+        osc->y1 = osc->amp*arm_sin_f32((FP32)(INT32S)osc->phase*ADD_RAD_PER_LSB);
+        osc->y2 = osc->amp*arm_sin_f32((FP32)(INT32S)(osc->phase - step)*ADD_RAD_PER_LSB);
+        osc->phase = osc->phase + step*samples;
+        if(osc->amp > 0.0f){
+            sum = sum + osc->amp;
+        }else{
+            sum = sum - osc->amp;
+        }
+    }
+    if(sum > 1.0f){
+        addGain = 32767.0f/sum;
+    }else{
+        addGain = 32767.0f;
+    }
+}
+
+/******************************************************************************
+ * AdditiveSample()
+ ******************************************************************************/
+INT32S AdditiveSample(INT32U phase, INT32U inc){
+    ADD_OSC *osc = &addOsc[0];
+    ADD_OSC *end = &addOsc[addCount];
+    FP32 acc = 0.0f;
+    FP32 y0;
+
+    (void)phase;
+    (void)inc;
+    for(; osc < end; osc++){
+        y0 = osc->coef*osc->y1 - osc->y2;
+        osc->y2 = osc->y1;
+        osc->y1 = y0;
+        acc = acc + y0;
+    }
+    return (INT32S)(acc*addGain);
+}
+
+/******************************************************************************
+ * AdditiveBudgetMeasure() - The partial set is saved and restored around
+ *  the timing runs, which use full scale partials at a mid band step. The
+ *  DAC DMA interrupt is already live, so each run is timed with interrupts
+ *  off to keep ISR time out of the figures. One run is about 0.1ms.
+ ******************************************************************************/
+void AdditiveBudgetMeasure(INT16U samples, INT32U rate_hz){
+    ADD_OSC saved[ADD_MAX_PARTIALS];
+    INT8U saved_count = addCount;
+    INT32U cycles[2];
+    INT32U start;
+    INT32U run_cycles;
+    INT32U avail;
+    INT32U fit;
+    INT16U n;
+    INT8U k;
+    INT8U run;
+    INT8U pass;
+    CPU_SR_ALLOC();
+
+    HalCycleCountStart();
+
+    for(k = 0; k < ADD_MAX_PARTIALS; k++){
+        saved[k] = addOsc[k];
+        addPartialSet(k, (k + 1u)*ADD_RATIO_ONE, 1.0f, 0);
+    }
+    for(pass = 0; pass < 2u; pass++){
+        addCountSet((pass == 0u) ? 1u : ADD_MAX_PARTIALS);
+        cycles[pass] = 0xFFFFFFFFu;
+        for(run = 0; run < ADD_BUDGET_RUNS; run++){
+            CPU_CRITICAL_ENTER();
+            start = HalCycleCount();
+            AdditiveBlockStart(0x01000000u, samples);
+            for(n = 0; n < samples; n++){
+                (void)AdditiveSample(0, 0);
+            }
+            run_cycles = HalCycleCount() - start;
+            CPU_CRITICAL_EXIT();
+            if(run_cycles < cycles[pass]){
+                cycles[pass] = run_cycles;
+            }else{}
+        }
+    }
+    for(k = 0; k < ADD_MAX_PARTIALS; k++){
+        addOsc[k] = saved[k];
+    }
+    addCount = saved_count;
+
+    addBudget.block_cycles = (INT32U)(((INT64U)TB_CORE_CLOCK*samples)/rate_hz);
+    addBudget.partial_cycles = (cycles[1] - cycles[0])/(ADD_MAX_PARTIALS - 1u);
+    addBudget.fixed_cycles = cycles[0] - addBudget.partial_cycles;
+    avail = (addBudget.block_cycles/100u)*ADD_BUDGET_PCT;
+    if((avail > addBudget.fixed_cycles) && (addBudget.partial_cycles != 0)){
+        fit = (avail - addBudget.fixed_cycles)/addBudget.partial_cycles;
+    }else{
+        fit = 0;
+    }
+    addBudget.partials_fit = fit;
+}
+
+/******************************************************************************
+ * AdditiveBudgetGet()
+ ******************************************************************************/
+void AdditiveBudgetGet(ADD_BUDGET *budget){
+    *budget = addBudget;
+}
+
+/******************************************************************************
+ * addPartialSet() - Sets partial 'idx'. 'ratio' is the frequency over the
+ *  fundamental in Q16, 'amp' the relative amplitude and 'phase' the starting
+ *  phase, 2^32 per turn.
+ ******************************************************************************/
+static void addPartialSet(INT8U idx, INT32U ratio, FP32 amp, INT32U phase){
+    if(idx < ADD_MAX_PARTIALS){
+        addOsc[idx].ratio = ratio;
+        addOsc[idx].amp = amp;
+        addOsc[idx].phase = phase;
+    }else{}
+}
+
+/******************************************************************************
+ * addCountSet() - Number of partials summed, up to ADD_MAX_PARTIALS
+ ******************************************************************************/
+static void addCountSet(INT8U count){
+    if(count > ADD_MAX_PARTIALS){
+        count = ADD_MAX_PARTIALS;
+    }else{}
+    addCount = count;
+}
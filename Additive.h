@@ -0,0 +1,58 @@
+/********************************************************************
+* Additive.h - Header file for the additive (multi-tone) generator
+* Sums up to ADD_MAX_PARTIALS sine partials, each with its own
+* frequency ratio to the fundamental, amplitude and phase, so the
+* analyzer can be fed harmonics, beats or two sources at once.
+*
+* agent, 10/18/2026
+********************************************************************/
+#ifndef ADDITIVE_H_
+#define ADDITIVE_H_
+
+#define ADD_MAX_PARTIALS 8u
+#define ADD_RATIO_ONE 65536u            //Q16 ratio of the fundamental itself
+
+//Cost of the additive mode, measured by AdditiveBudgetMeasure()
+typedef struct{
+    INT32U block_cycles;        //Core cycles between two DAC blocks
+    INT32U fixed_cycles;        //Cycles per block with no partials
+    INT32U partial_cycles;      //Cycles per block added by each partial
+    INT32U partials_fit;        //Partials that would fit in ADD_BUDGET_PCT of a block
+} ADD_BUDGET;
+
+/******************************************************************************
+ * AdditiveInit() - Loads the default partial set, harmonics 1 to 4 and a
+ *  partial 1% above the fundamental that beats with it. The set is fixed
+ *  once WaveTask runs, it reads the partials mid block with no lock.
+ ******************************************************************************/
+void AdditiveInit(void);
+
+/******************************************************************************
+ * AdditiveBlockStart() - Seeds every partial's oscillator for a block of
+ *  'samples' at fundamental phase step 'inc'. Call before the block's
+ *  first AdditiveSample(). The partials hold that rate for the whole
+ *  block, so a glide comes out as one step per block; WaveFill() passes
+ *  the step the ramp reaches half way through to halve the error.
+ ******************************************************************************/
+void AdditiveBlockStart(INT32U inc, INT16U samples);
+
+/******************************************************************************
+ * AdditiveSample() - Next Q15 sample of the sum. Has the WAVE_FN shape but
+ *  runs off the oscillators seeded by AdditiveBlockStart(), so the
+ *  arguments are not used.
+ ******************************************************************************/
+INT32S AdditiveSample(INT32U phase, INT32U inc);
+
+/******************************************************************************
+ * AdditiveBudgetMeasure() - Times blocks of 'samples' with one partial and
+ *  with ADD_MAX_PARTIALS on the DWT cycle counter and works out how many
+ *  partials fit at 'rate_hz'. Run once from init, before WaveTask starts.
+ ******************************************************************************/
+void AdditiveBudgetMeasure(INT16U samples, INT32U rate_hz);
+
+/******************************************************************************
+ * AdditiveBudgetGet() - Copies the last budget report to *budget
+ ******************************************************************************/
+void AdditiveBudgetGet(ADD_BUDGET *budget);
+
+#endif
@@ -0,0 +1,314 @@
+/********************************************************************
+* Analyzer.c - Reentrant pitch analyzer
+* Frame analysis that used to live in ADCTask. Each frame has its DC
+* removed and is windowed in one batch pass, then goes through a
+* real FFT. The largest bin below Nyquist gives the frame estimate.
+* Frames start every ANA_HOP_SIZE samples and overlap by the rest.
+* Only every ANA_FFT_SIZE/ANA_HOP_SIZE-th frame goes into the note
+* average, so the frames averaged never overlap. A moving average of
+* the last ANA_AVG_SIZE of them is corrected for the measured gain
+* error and mapped to a note. All state is in the ANALYZER context.
+* Frame scratch is handed in by the caller so the module owns no
+* memory.
+*
+* agent, 10/18/2026
+********************************************************************/
+#include "MCUType.h"
+#include "DspArena.h"
+#include "Window.h"
+#include "Note.h"
+#include "Analyzer.h"
+
+#define ANA_FFT_BINS (ANA_FFT_SIZE/2u)  //Bins below Nyquist in the packed real FFT output
+#define ANA_OVERLAP (ANA_FFT_SIZE/ANA_HOP_SIZE)  //Hops per frame, frames this far apart don't overlap
+
+#define DC_Q 14                 //Fraction bits of the DC estimate. 16 bit samples keep it inside INT32S
+#define DC_SHIFT 11             //DC tracker pole at 1 - 2^-11, corner ~3.4Hz at 44.1kHz
+
+//Offset and gain errors from frequency calculations (found experimentally)
+#define OFFSET_ERR 0                    //Measured frequency at ~0Hz accurate
+#define GAIN_ERR (30 + OFFSET_ERR)      //Measured frequency at 20kHz is 30Hz too high
+
+/* A hop has to be whole blocks of the unrolled conversion and fit in a frame */
+typedef INT8U ANA_HOP_CHECK[(((ANA_HOP_SIZE % 4u) == 0) && (ANA_HOP_SIZE <= ANA_FFT_SIZE)) ? 1 : -1];
+
+static void anFrame(ANALYZER *an, const INT16U *stage);
+static void anStageConvert(ANALYZER *an, const INT16U *stage, FP32 *frame, const FP32 *win);
+static void anAvgAdd(ANALYZER *an);
+static void anNoteUpdate(ANALYZER *an);
+
+/******************************************************************************
+ * AnalyzerInit() - Sets up the real FFT once and clears the running state.
+ *  The note starts as "X" so the first real note is always an event.
+ ******************************************************************************/
+void AnalyzerInit(ANALYZER *an, void *scratch, INT32U fs_num, INT32U fs_den,
+                  ANA_NOTE_FN note_fn, void *note_arg){
+    INT8U i;
+
+    while(arm_rfft_fast_init_f32(&an->fft, ANA_FFT_SIZE) != ARM_MATH_SUCCESS){}   //Error Trap
+    an->scratch = scratch;
+    an->fill = 0;
+    an->window = WIN_HANN;
+    an->dc_seeded = FALSE;
+    an->dc_est = 0;
+    an->fs_num = fs_num;
+    an->fs_den = fs_den;
+    for(i = 0; i < ANA_AVG_SIZE; i++){
+        an->freq[i] = 0;
+    }
+    an->freq_sum = 0;
+    an->freq_pos = 0;
+    an->freq_cnt = 0;
+    an->frames = 0;
+    an->frame_hz = 0;
+    an->note.note = "X";
+    an->note.oct = 255;
+    an->note.cents = 0;
+    an->note.freq = 0;
+    an->note_new = FALSE;
+    an->note_fn = note_fn;
+    an->note_arg = note_arg;
+}
+
+/******************************************************************************
+ * AnalyzerRateSet() - Changes the sample rate used for bin to Hz conversion
+ ******************************************************************************/
+void AnalyzerRateSet(ANALYZER *an, INT32U fs_num, INT32U fs_den){
+    an->fs_num = fs_num;
+    an->fs_den = fs_den;
+}
+
+/******************************************************************************
+ * AnalyzerWindowSet() - Selects the window applied to each frame
+ ******************************************************************************/
+void AnalyzerWindowSet(ANALYZER *an, INT8U win){
+    if(win < (INT8U)WIN_NUM){
+        an->window = win;
+    } else{}
+}
+
+/******************************************************************************
+ * AnalyzerFlush() - The moving average is kept, the estimates before the
+ *  break are still good.
+ ******************************************************************************/
+void AnalyzerFlush(ANALYZER *an){
+    an->fill = 0;
+    an->dc_seeded = FALSE;
+}
+
+/******************************************************************************
+ * AnalyzerPush() - Samples are staged until the frame is complete. After
+ *  each frame the last ANA_FFT_SIZE - ANA_HOP_SIZE samples move down to
+ *  start the next one.
+ ******************************************************************************/
+void AnalyzerPush(ANALYZER *an, const INT16U *samples, INT32U n){
+    INT32U take;
+    INT32U i;
+
+    //Seed the DC tracker with the first sample so it starts settled
+    if((an->dc_seeded == FALSE) && (n > 0)){
+        an->dc_est = (INT32S)samples[0] << DC_Q;
+        an->dc_seeded = TRUE;
+    } else{}
+
+    while(n > 0){
+        take = ANA_FFT_SIZE - an->fill;
+        if(take > n){
+            take = n;
+        } else{}
+        for(i = 0; i < take; i++){
+            an->stage[an->fill + i] = samples[i];
+        }
+        an->fill = an->fill + (INT16U)take;
+        if(an->fill == ANA_FFT_SIZE){
+            anFrame(an, an->stage);
+            for(i = 0; i < (ANA_FFT_SIZE - ANA_HOP_SIZE); i++){
+                an->stage[i] = an->stage[i + ANA_HOP_SIZE];
+            }
+            an->fill = ANA_FFT_SIZE - ANA_HOP_SIZE;
+        } else{}
+        samples = samples + take;
+        n = n - take;
+    }
+}
+
+/******************************************************************************
+ * AnalyzerNotePoll() - Copies out the last note event
+ ******************************************************************************/
+INT8U AnalyzerNotePoll(ANALYZER *an, NOTE *note){
+    INT8U fresh = an->note_new;
+
+    *note = an->note;
+    an->note_new = FALSE;
+    return fresh;
+}
+
+/******************************************************************************
+ * AnalyzerFrameHz() - Estimate of the last frame
+ ******************************************************************************/
+INT32U AnalyzerFrameHz(const ANALYZER *an){
+    return an->frame_hz;
+}
+
+/******************************************************************************
+ * AnalyzerBinHz() - FFT bin spacing, fs/N
+ ******************************************************************************/
+INT32U AnalyzerBinHz(const ANALYZER *an){
+    return (INT32U)((INT64U)an->fs_num/((INT64U)an->fs_den*ANA_FFT_SIZE));
+}
+
+/******************************************************************************
+ * AnalyzerFrames() - Frames analyzed since AnalyzerInit()
+ ******************************************************************************/
+INT32U AnalyzerFrames(const ANALYZER *an){
+    return an->frames;
+}
+
+/******************************************************************************
+ * anFrame() - Analyzes one complete frame of ANA_FFT_SIZE samples
+ ******************************************************************************/
+static void anFrame(ANALYZER *an, const INT16U *stage){
+    FP32 *input = an->scratch;                  //Real FFT input frame
+    FP32 *spectrum = input + DSP_FFT_BUF_WORDS; //Packed real FFT output, bin k at [2k],[2k+1]
+    FP32 *mag = input;                          //Magnitudes, written over the spent input
+    FP32 max_value;
+    INT32U max_index;
+
+    anStageConvert(an, stage, input, WindowTableGet((WINDOW_T)an->window));
+
+    //The input is real, so a real FFT does half the work of the complex one and
+    //only produces the bins below Nyquist
+    arm_rfft_fast_f32(&an->fft, input, spectrum, 0);
+    //Magnitude of each bin below Nyquist
+    arm_cmplx_mag_f32(spectrum, mag, ANA_FFT_BINS);
+
+    //Bin 0 packs DC with the Nyquist bin, neither is a pitch
+    mag[0] = 0;
+
+    //Finds max magnitude in output spectrum with corresponding index
+    arm_max_f32(mag, ANA_FFT_BINS, &max_value, &max_index);
+
+    //Calculate frequency from location of max magnitude, f = index*fs/N with the
+    //achieved rate fs = num/den
+    an->frame_hz = (INT32U)(((INT64U)max_index*an->fs_num)/((INT64U)an->fs_den*ANA_FFT_SIZE));
+    an->frames++;
+
+    //Only frames that do not overlap go into the average, so it spans the same
+    //ANA_AVG_SIZE independent frames the GAIN_ERR correction was measured with
+    if((an->frames % ANA_OVERLAP) == 0){
+        anAvgAdd(an);
+    } else{}
+}
+
+/******************************************************************************
+ * anAvgAdd() - Moving average, the new estimate replaces the oldest. Maps
+ *  the average to a note once it is full.
+ ******************************************************************************/
+static void anAvgAdd(ANALYZER *an){
+    if(an->freq_cnt == ANA_AVG_SIZE){
+        an->freq_sum = an->freq_sum - an->freq[an->freq_pos];
+    } else{
+        an->freq_cnt++;
+    }
+    an->freq[an->freq_pos] = an->frame_hz;
+    an->freq_sum = an->freq_sum + an->frame_hz;
+    an->freq_pos++;
+    if(an->freq_pos == ANA_AVG_SIZE){
+        an->freq_pos = 0;
+    } else{}
+    if(an->freq_cnt == ANA_AVG_SIZE){
+        anNoteUpdate(an);
+    } else{}
+}
+
+/******************************************************************************
+ * anNoteUpdate() - Averages the frame estimates, corrects for the offset and
+ *  gain errors and maps the result to a note. A note that differs from the
+ *  last one is an event.
+ ******************************************************************************/
+static void anNoteUpdate(ANALYZER *an){
+    NOTE note;
+
+    //Take average of frequency samples
+    note.freq = an->freq_sum/ANA_AVG_SIZE;
+
+    //Adjust measured frequency for offset and gain errors
+    note.freq = note.freq - OFFSET_ERR;
+    note.freq = (note.freq*20000)/(20000 + GAIN_ERR - OFFSET_ERR);
+
+    //Find note, octave and cents of measured frequency
+    NoteFromFreq(&note);
+
+    if((*note.note != *an->note.note)
+        || (note.oct != an->note.oct)
+        || (note.freq != an->note.freq)){
+        an->note = note;
+        an->note_new = TRUE;
+        if(an->note_fn != 0){
+            an->note_fn(an->note_arg, &an->note);
+        } else{}
+    } else{}
+}
+
+/*****************************************************************************************
+ * anStageConvert() - Batch converts one frame of staged samples into the real
+ * FFT's input. DC removal and the window are fused into this pass.
+ * DC is removed by a one-pole tracker, y = x - dc, dc += y/2^DC_SHIFT, whose state
+ * carries across frames. The output stays in Q14, the scale does not matter to the peak
+ * search. The window table holds w[0..N/2], the second half of the frame walks it
+ * backwards. The next frame starts ANA_HOP_SIZE samples in, so the tracker state
+ * there is kept for it.
+ * Unrolled by four like arm_q15_to_float().
+ *****************************************************************************************/
+static void anStageConvert(ANALYZER *an, const INT16U *stage, FP32 *frame, const FP32 *win){
+    INT32S dc = an->dc_est;
+    INT32S d0, d1, d2, d3;
+    const INT16U *src = stage;
+    FP32 *dst = frame;
+    const FP32 *w = win;
+    const INT16U *hop_end = stage + ANA_HOP_SIZE;
+    INT16U blk;
+
+    //First half, window read forwards from w[0]
+    for(blk = ANA_FFT_SIZE/8; blk > 0; blk--){
+        d0 = ((INT32S)src[0] << DC_Q) - dc;
+        dc = dc + (d0 >> DC_SHIFT);
+        d1 = ((INT32S)src[1] << DC_Q) - dc;
+        dc = dc + (d1 >> DC_SHIFT);
+        d2 = ((INT32S)src[2] << DC_Q) - dc;
+        dc = dc + (d2 >> DC_SHIFT);
+        d3 = ((INT32S)src[3] << DC_Q) - dc;
+        dc = dc + (d3 >> DC_SHIFT);
+        dst[0] = (FP32)d0 * w[0];
+        dst[1] = (FP32)d1 * w[1];
+        dst[2] = (FP32)d2 * w[2];
+        dst[3] = (FP32)d3 * w[3];
+        src += 4;
+        dst += 4;
+        if(src == hop_end){
+            an->dc_est = dc;        //Tracker state at the start of the next frame
+        } else{}
+        w += 4;
+    }
+    //Second half, window read backwards from w[N/2]
+    for(blk = ANA_FFT_SIZE/8; blk > 0; blk--){
+        d0 = ((INT32S)src[0] << DC_Q) - dc;
+        dc = dc + (d0 >> DC_SHIFT);
+        d1 = ((INT32S)src[1] << DC_Q) - dc;
+        dc = dc + (d1 >> DC_SHIFT);
+        d2 = ((INT32S)src[2] << DC_Q) - dc;
+        dc = dc + (d2 >> DC_SHIFT);
+        d3 = ((INT32S)src[3] << DC_Q) - dc;
+        dc = dc + (d3 >> DC_SHIFT);
+        dst[0] = (FP32)d0 * w[0];
+        dst[1] = (FP32)d1 * w[-1];
+        dst[2] = (FP32)d2 * w[-2];
+        dst[3] = (FP32)d3 * w[-3];
+        src += 4;
+        dst += 4;
+        if(src == hop_end){
+            an->dc_est = dc;        //Tracker state at the start of the next frame
+        } else{}
+        w -= 4;
+    }
+}
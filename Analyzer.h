@@ -0,0 +1,106 @@
+/********************************************************************
+* Analyzer.h - Header file for the pitch analyzer module
+* The pitch detection from ADCTask as a reentrant module. All state
+* lives in an ANALYZER context, so several analyzers can run side by
+* side. Samples are pushed in blocks of any size and note events come
+* back through a callback, a poll, or both. A new frame is analyzed
+* every ANA_HOP_SIZE samples. Only frames that do not overlap feed the
+* note average, so a note can change once per ANA_FFT_SIZE samples.
+* Has no RTOS or hardware dependencies.
+* DspArena.h (for DSP_FFT_SIZE) and Note.h must be included first.
+*
+* agent, 10/18/2026
+********************************************************************/
+#ifndef ANALYZER_H_
+#define ANALYZER_H_
+
+#define ANA_FFT_SIZE DSP_FFT_SIZE   //Real samples per frame
+#define ANA_HOP_SIZE DSP_HOP_SIZE   //Samples between frame starts, frames overlap by the rest
+#define ANA_AVG_SIZE 20u            //Non-overlapping frame estimates in the moving average (1 = no averaging)
+
+//Scratch used while a frame is analyzed, the FFT input frame and its packed spectrum
+#define ANA_SCRATCH_WORDS (DSP_FFT_BUF_WORDS + DSP_SPEC_WORDS)
+#define ANA_SCRATCH_BYTES (ANA_SCRATCH_WORDS*4u)
+
+//Note event callback. Called from AnalyzerPush() whenever the note changes
+typedef void (*ANA_NOTE_FN)(void *arg, const NOTE *note);
+
+//Analyzer context. Fields are private to Analyzer.c
+typedef struct{
+    arm_rfft_fast_instance_f32 fft;
+    FP32 *scratch;                  //ANA_SCRATCH_BYTES, may be shared by analyzers
+                                    //that never run at the same time
+    INT16U stage[ANA_FFT_SIZE];     //Frame being filled, the last frame's overlap first
+    INT16U fill;                    //Samples in stage[]
+    INT8U window;                   //WINDOW_T applied to each frame
+    INT8U dc_seeded;                //FALSE until the first sample seeds dc_est
+    INT32S dc_est;                  //DC estimate at stage[0], Q14
+    INT32U fs_num;                  //Sample rate = fs_num/fs_den Hz
+    INT32U fs_den;
+    INT32U freq[ANA_AVG_SIZE];      //Last frame estimates, for the moving average
+    INT32U freq_sum;
+    INT8U freq_pos;                 //Oldest estimate, overwritten next
+    INT8U freq_cnt;                 //Estimates held, up to ANA_AVG_SIZE
+    INT32U frames;                  //Frames analyzed
+    INT32U frame_hz;                //Estimate of the last frame
+    NOTE note;                      //Last note event
+    INT8U note_new;                 //TRUE until AnalyzerNotePoll() reads note
+    ANA_NOTE_FN note_fn;
+    void *note_arg;
+} ANALYZER;
+
+/******************************************************************************
+ * AnalyzerInit() - Sets up 'an' for sample rate fs_num/fs_den Hz. 'scratch'
+ *  has to be ANA_SCRATCH_BYTES, aligned for FP32. 'note_fn' may be 0 if the
+ *  caller polls.
+ ******************************************************************************/
+void AnalyzerInit(ANALYZER *an, void *scratch, INT32U fs_num, INT32U fs_den,
+                  ANA_NOTE_FN note_fn, void *note_arg);
+
+/******************************************************************************
+ * AnalyzerRateSet() - Changes the sample rate. Takes effect on the next frame.
+ ******************************************************************************/
+void AnalyzerRateSet(ANALYZER *an, INT32U fs_num, INT32U fs_den);
+
+/******************************************************************************
+ * AnalyzerWindowSet() - Selects the WINDOW_T applied to each frame
+ ******************************************************************************/
+void AnalyzerWindowSet(ANALYZER *an, INT8U win);
+
+/******************************************************************************
+ * AnalyzerFlush() - Drops the samples of the frame being filled and reseeds
+ *  the DC tracker, for a break in the input such as a new ADC resolution.
+ *  The next frame needs ANA_FFT_SIZE fresh samples.
+ ******************************************************************************/
+void AnalyzerFlush(ANALYZER *an);
+
+/******************************************************************************
+ * AnalyzerPush() - Feeds 'n' unsigned 16 bit samples. Every frame completed
+ *  by them is analyzed before it returns, the first after ANA_FFT_SIZE
+ *  samples and then one every ANA_HOP_SIZE.
+ ******************************************************************************/
+void AnalyzerPush(ANALYZER *an, const INT16U *samples, INT32U n);
+
+/******************************************************************************
+ * AnalyzerNotePoll() - Copies the last note event to 'note'. Returns TRUE
+ *  if it is new since the last poll.
+ ******************************************************************************/
+INT8U AnalyzerNotePoll(ANALYZER *an, NOTE *note);
+
+/******************************************************************************
+ * AnalyzerFrameHz() - Estimate of the last frame before averaging and error
+ *  correction, in Hz
+ ******************************************************************************/
+INT32U AnalyzerFrameHz(const ANALYZER *an);
+
+/******************************************************************************
+ * AnalyzerBinHz() - FFT bin spacing at the current sample rate, in Hz
+ ******************************************************************************/
+INT32U AnalyzerBinHz(const ANALYZER *an);
+
+/******************************************************************************
+ * AnalyzerFrames() - Frames analyzed since AnalyzerInit()
+ ******************************************************************************/
+INT32U AnalyzerFrames(const ANALYZER *an);
+
+#endif
@@ -7,113 +7,154 @@
 #include "MCUType.h"
 #include "app_cfg.h"
 #include "os.h"
+#include "Hal.h"
 #include "K65TWR_GPIO.h"
+#include "Timebase.h"
+#include "Profile.h"
 #include "DMA.h"
 
 #define WAVE_DMA_OUT_CH 0
 #define SIZE_CODE_16BIT 1
 #define WAVE_BYTES_PER_SAMPLE 2
-#define WAVE_NUM_BLOCKS 2
-#define WAVE_SAMPLES_PER_BLOCK 60  //number of items in each block
-#define WAVE_BYTES_PER_BUFFER 240
+#define WAVE_BYTES_PER_BLOCK (DMA_RING_BLOCK_SAMPLES*WAVE_BYTES_PER_SAMPLE)
+#define DMA_LOOP_ARM_MIN 2          //Transfers that must remain in the major loop to arm a link
+
+/* The circular source window must cover exactly the ring */
+typedef INT8U DMA_RING_SMOD_CHECK[((1u << DMA_RING_SMOD) == DMA_RING_BYTES) ? 1 : -1];
 
 typedef struct{
     OS_SEM flag;
     INT8U index;
 }DMA_RDY;
 
+/* In memory image of a channel TCD, the layout the eDMA scatter/gather
+ * engine loads from. Must be 32 byte aligned. */
+typedef struct{
+    INT32U saddr;
+    INT16S soff;
+    INT16U attr;
+    INT32U nbytes;
+    INT32S slast;
+    INT32U daddr;
+    INT16S doff;
+    INT16U citer;
+    INT32U dlast_sga;
+    INT16U csr;
+    INT16U biter;
+}DMA_TCD;
+
 DMA_RDY dmaBlockRdy;
 
+static INT32U dmaRingBase;
+static DMA_TCD dmaStreamTcd __attribute__((aligned(32)));  //Block ring, as set up by DMAInit()
+static DMA_TCD dmaLoopTcd __attribute__((aligned(32)));    //Wavetable loop, links to itself
+static volatile INT8U dmaLoopActive = 0;
+static volatile INT8U dmaBlockFilled[DMA_RING_BLOCKS];    //Set by WaveTask, cleared when played
+static DMA_STATS dmaStats;
+
+static void DMATcdSave(DMA_TCD *tcd);
+static INT8U DMABlockPlaying(void);
+
 
 /*****************************************************************************************
 * DMA Initializations
-* - Argument passed through is an address to the Wave ping-pong buffer.
+* - Argument passed through is the address of the Wave block ring, DMA_RING_BYTES long
+*   and aligned to DMA_RING_BYTES.
 * - DMA will transfer data to the DAC from the Wave block currently not being written to.
 *****************************************************************************************/
 void DMAInit(INT16U *WaveOut){
 
     OS_ERR os_err;
     OSSemCreate(&dmaBlockRdy.flag, "Block Ready", 0, &os_err);
-    // dmaInBlockRdy.index indicates the buffer currently not being used by the DMA
-    // in the Ping-Pong scheme.
-    // This is a bit more open loop than I like but there doesn't seem to be a status
-    // bit that distinguishes between a half-full interrupt,INTHALF, and a full.
-    // interrupt, INTMAJOR. Bottom line, this has to start at one. The DMA fills the
-    // [0] block first so, by the time     the HALFINT happens, it is working on the [1]
-    // block. The ISR toggles the initial value to zero so the [0] block is processed
-    //first.
-    dmaBlockRdy.index = 1;
+    // dmaBlockRdy.index is the block WaveTask writes next. The ISR works it out
+    // from the DMA source address, so it can't drift from what is being played.
+    dmaBlockRdy.index = DMA_RING_BLOCKS - 1u;
+    DMAStatsReset();
+    //Modulo addressing wraps on a DMA_RING_BYTES boundary
+    dmaRingBase = (INT32U)WaveOut;
+    while((dmaRingBase & (DMA_RING_BYTES - 1u)) != 0){}     //Error Trap, ring misaligned
     // Turn on clocks for the DMA, DMAMUX, DAC, and PIT
-    SIM_SCGC6 |= SIM_SCGC6_DMAMUX(1) | SIM_SCGC6_PIT(1);
-    SIM_SCGC7 |= SIM_SCGC7_DMA(1);
-    SIM_SCGC2 |= SIM_SCGC2_DAC0(1);
+    HalGateSet(HAL_SCGC6, SIM_SCGC6_DMAMUX(1) | SIM_SCGC6_PIT(1));
+    HalGateSet(HAL_SCGC7, SIM_SCGC7_DMA(1));
+    HalGateSet(HAL_SCGC2, SIM_SCGC2_DAC0(1));
 
-    VREF_SC = VREF_SC_VREFEN(1) | VREF_SC_REGEN(1);
-    DAC0_C0 = DAC_C0_DACEN(1) | DAC_C0_DACRFS(1) | DAC_C0_DACTRGSEL(0);
-    DAC0_C1 |= DAC_C1_DMAEN(1); //enable DMA trigger
+    HalVrefSet(VREF_SC_VREFEN(1) | VREF_SC_REGEN(1));
+    //Enable the DAC and its DMA trigger
+    HalDacCfgSet(DAC_C0_DACEN(1) | DAC_C0_DACRFS(1) | DAC_C0_DACTRGSEL(0), DAC_C1_DMAEN(1));
 
     //Make sure DMAMUX is disabled
-    DMAMUX_CHCFG(WAVE_DMA_OUT_CH) |= DMAMUX_CHCFG_ENBL(0)|DMAMUX_CHCFG_TRIG(0);
+    HalDmaMuxSet(WAVE_DMA_OUT_CH, HalDmaMuxGet(WAVE_DMA_OUT_CH) | DMAMUX_CHCFG_ENBL(0)|DMAMUX_CHCFG_TRIG(0));
     //Configure DMA Channel
     //set source address to read from WaveOut
-    DMA_SADDR(WAVE_DMA_OUT_CH) = DMA_SADDR_SADDR(WaveOut);
-    //Source size is 2 bytes, destination size is 2 bytes. No modulo feature.
-    DMA_ATTR(WAVE_DMA_OUT_CH) = DMA_ATTR_SMOD(0) | DMA_ATTR_SSIZE(SIZE_CODE_16BIT) | DMA_ATTR_DMOD(0) | DMA_ATTR_DSIZE(SIZE_CODE_16BIT);
-    DMA_SOFF(WAVE_DMA_OUT_CH) = DMA_SOFF_SOFF(WAVE_BYTES_PER_SAMPLE);
+    HalDmaTcdSet(WAVE_DMA_OUT_CH, HAL_TCD_SADDR, DMA_SADDR_SADDR(WaveOut));
+    //Source size is 2 bytes, destination size is 2 bytes. The source wraps around the ring.
+    HalDmaTcdSet(WAVE_DMA_OUT_CH, HAL_TCD_ATTR, DMA_ATTR_SMOD(DMA_RING_SMOD) | DMA_ATTR_SSIZE(SIZE_CODE_16BIT) | DMA_ATTR_DMOD(0) | DMA_ATTR_DSIZE(SIZE_CODE_16BIT));
+    HalDmaTcdSet(WAVE_DMA_OUT_CH, HAL_TCD_SOFF, DMA_SOFF_SOFF(WAVE_BYTES_PER_SAMPLE));
     //Minor loop size is the sample size
-    DMA_NBYTES_MLNO(WAVE_DMA_OUT_CH) = DMA_NBYTES_MLNO_NBYTES(WAVE_BYTES_PER_SAMPLE);
-    //Set minor loop iteration counters to number of minor loops in the major loop
-    DMA_CITER_ELINKNO(WAVE_DMA_OUT_CH) = DMA_CITER_ELINKNO_ELINK(0)|DMA_CITER_ELINKNO_CITER(WAVE_NUM_BLOCKS*WAVE_SAMPLES_PER_BLOCK);
-    DMA_BITER_ELINKNO(WAVE_DMA_OUT_CH) = DMA_BITER_ELINKNO_ELINK(0)|DMA_BITER_ELINKNO_BITER(WAVE_NUM_BLOCKS*WAVE_SAMPLES_PER_BLOCK);
-    //After major loop is done set the address back to the first byte of the buffer
-    DMA_SLAST(WAVE_DMA_OUT_CH) = DMA_SLAST_SLAST(-(WAVE_BYTES_PER_BUFFER));
+    HalDmaTcdSet(WAVE_DMA_OUT_CH, HAL_TCD_NBYTES, DMA_NBYTES_MLNO_NBYTES(WAVE_BYTES_PER_SAMPLE));
+    //One major loop per block, so every major loop ends on a block boundary
+    HalDmaTcdSet(WAVE_DMA_OUT_CH, HAL_TCD_CITER, DMA_CITER_ELINKNO_ELINK(0)|DMA_CITER_ELINKNO_CITER(DMA_RING_BLOCK_SAMPLES));
+    HalDmaTcdSet(WAVE_DMA_OUT_CH, HAL_TCD_BITER, DMA_BITER_ELINKNO_ELINK(0)|DMA_BITER_ELINKNO_BITER(DMA_RING_BLOCK_SAMPLES));
+    //No rewind, the modulo wraps the source back to block [0]
+    HalDmaTcdSet(WAVE_DMA_OUT_CH, HAL_TCD_SLAST, DMA_SLAST_SLAST(0));
     //Set transmit destination address to the DAC data register
-    DMA_DADDR(WAVE_DMA_OUT_CH) = DMA_DADDR_DADDR(&DAC0_DAT0L);
+    HalDmaTcdSet(WAVE_DMA_OUT_CH, HAL_TCD_DADDR, DMA_DADDR_DADDR(HalDacDataAddr()));
     //No change in destination address
-    DMA_DOFF(WAVE_DMA_OUT_CH) = DMA_DOFF_DOFF(0);
+    HalDmaTcdSet(WAVE_DMA_OUT_CH, HAL_TCD_DOFF, DMA_DOFF_DOFF(0));
     //No adjustment to destination address.
-    DMA_DLAST_SGA(WAVE_DMA_OUT_CH) = DMA_DLAST_SGA_DLASTSGA(0);
-
-    //PIT setup for 48k samples per second
-    PIT_MCR &= PIT_MCR_MDIS(0);
-    PIT_TCTRL0 |= PIT_TCTRL_TIE(1);
-    PIT_TCTRL0 |= PIT_TCTRL_TEN(1);
-    //PIT_LDVAL0 |= 120;//testing lower values for faster Dac sampling
-    PIT_LDVAL0 |= 1249;                 /* sets the timer start value */
-    PIT_TFLG0 |= PIT_TFLG_TIF(1);       /* clear ISF Flag and enable IRQ */
-
-    //Enable interrupt at half filled buffer and end of major loop.
-    //This allows "ping-pong" buffer processing.
-    DMA_CSR(WAVE_DMA_OUT_CH) = DMA_CSR_ESG(0) | DMA_CSR_MAJORELINK(0) | DMA_CSR_BWC(3) | DMA_CSR_INTHALF(1) |  DMA_CSR_INTMAJOR(1) | DMA_CSR_DREQ(0) | DMA_CSR_START(0);
+    HalDmaTcdSet(WAVE_DMA_OUT_CH, HAL_TCD_DLAST_SGA, DMA_DLAST_SGA_DLASTSGA(0));
+
+    //PIT0 paces the DAC, the timebase picks the reload for DMA_DAC_SAMPLE_RATE
+    TimebasePitStart(TB_PIT_DAC, DMA_DAC_SAMPLE_RATE);
+    HalPitIrqEnable(TB_PIT_DAC);
+    HalPitFlagClear(TB_PIT_DAC);        /* clear ISF Flag and enable IRQ */
+
+    //Enable interrupt at the end of each major loop, i.e. each block.
+    HalDmaTcdSet(WAVE_DMA_OUT_CH, HAL_TCD_CSR, DMA_CSR_ESG(0) | DMA_CSR_MAJORELINK(0) | DMA_CSR_BWC(3) | DMA_CSR_INTHALF(0) |  DMA_CSR_INTMAJOR(1) | DMA_CSR_DREQ(0) | DMA_CSR_START(0));
+    //Keep a copy of the ring setup so the loop can link back to it
+    DMATcdSave(&dmaStreamTcd);
     //Set the DMAMUX to source 60, enable triggering and enable DMAMUX
-    DMAMUX_CHCFG(WAVE_DMA_OUT_CH) = DMAMUX_CHCFG_ENBL(1)|DMAMUX_CHCFG_TRIG(1)|DMAMUX_CHCFG_SOURCE(60);
+    HalDmaMuxSet(WAVE_DMA_OUT_CH, DMAMUX_CHCFG_ENBL(1)|DMAMUX_CHCFG_TRIG(1)|DMAMUX_CHCFG_SOURCE(60));
 
     //enable DMA interrupt
-    NVIC_EnableIRQ(WAVE_DMA_OUT_CH);
+    HalIrqEnable(WAVE_DMA_OUT_CH);
     //All set to go, enable DMA channel(s)!
-    DMA_SERQ = DMA_SERQ_SERQ(WAVE_DMA_OUT_CH);
+    HalDmaReqEnable(WAVE_DMA_OUT_CH);
 
 }
 
 /*****************************************************************************************
 * DMA IRQ
 * - Posting dmaBlockRdy.flag tells WaveTask that the DMA is moving on to next block
-* - dmaBlockRdy.index tells WaveTask which block to currently write to.
+* - dmaBlockRdy.index tells WaveTask which block to currently write to, the one
+*   just finished, which is furthest from being played again.
 *****************************************************************************************/
 void DMA0_DMA16_IRQHandler(void){
     OS_ERR os_err;
-    NVIC_ClearPendingIRQ(DMA0_DMA16_IRQn);
-    DMA_CINT = DMA_CINT_CINT(0);
-    if(dmaBlockRdy.index == 1){
-        dmaBlockRdy.index = 0u;
+    INT8U playing;
+    ProfileBegin(PROF_DMA_ISR);
+    HalIrqPendClear(DMA0_DMA16_IRQn);
+    HalDmaIntClear(WAVE_DMA_OUT_CH);
+    if((HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_CSR) & DMA_CSR_INTMAJOR_MASK) == 0){
+        //Last ring interrupt, the loop TCD has been loaded. No block to fill.
+        dmaLoopActive = 1u;
     }else{
-        dmaBlockRdy.index = 1u;
-    }
-    //dmaBlockRdy.index ^= 1;
-    //dmaBlockRdy.flag is pended for in WaveTask()
-    (void)OSSemPost(&(dmaBlockRdy.flag), OS_OPT_POST_1, &os_err);
-    while(os_err != OS_ERR_NONE){
+        playing = DMABlockPlaying();
+        //The block now playing must have been refilled since its last pass
+        if(dmaBlockFilled[playing] == 0u){
+            dmaStats.misses++;
+        }else{
+            dmaBlockFilled[playing] = 0u;
+        }
+        dmaStats.blocks++;
+        dmaBlockRdy.index = (INT8U)((playing + DMA_RING_BLOCKS - 1u) % DMA_RING_BLOCKS);
+        //dmaBlockRdy.flag is pended for in WaveTask()
+        ProfileRelease(PROF_WAVE);
+        (void)OSSemPost(&(dmaBlockRdy.flag), OS_OPT_POST_1, &os_err);
+        while(os_err != OS_ERR_NONE){
+        }
     }
+    ProfileEnd(PROF_DMA_ISR);
 }
 
 /*************************************************************************
@@ -129,3 +170,151 @@ void DMAPend(INT8U *buffer_layer){
     }
     *buffer_layer = dmaBlockRdy.index;
 }
+
+/*************************************************************************
+ * DMABlockDone() - Called by WaveTask once 'block' has been written.
+ *  Records the slack, the DAC samples left before the DMA reaches it.
+ *************************************************************************/
+void DMABlockDone(INT8U block){
+    INT8U playing;
+    INT32U slack;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    playing = DMABlockPlaying();
+    if(playing == block){
+        slack = 0;                      //Already being played, the ISR counts the miss
+    }else{
+        slack = (HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_CITER) & DMA_CITER_ELINKNO_CITER_MASK) +
+                (((block + DMA_RING_BLOCKS - playing - 1u) % DMA_RING_BLOCKS)*DMA_RING_BLOCK_SAMPLES);
+        dmaBlockFilled[block] = 1u;
+    }
+    if(slack < dmaStats.min_slack){
+        dmaStats.min_slack = slack;
+    }else{}
+    CPU_CRITICAL_EXIT();
+}
+
+/*************************************************************************
+ * DMAStatsGet() - Copies the underrun counters to *stats
+ *************************************************************************/
+void DMAStatsGet(DMA_STATS *stats){
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    *stats = dmaStats;
+    CPU_CRITICAL_EXIT();
+}
+
+/*************************************************************************
+ * DMAStatsReset() - Clears the underrun counters. Every block counts as
+ *  filled, the ring is full of whatever it held before.
+ *************************************************************************/
+void DMAStatsReset(void){
+    INT8U block;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    dmaStats.misses = 0;
+    dmaStats.blocks = 0;
+    dmaStats.min_slack = 0xFFFFFFFFu;
+    for(block = 0; block < DMA_RING_BLOCKS; block++){
+        dmaBlockFilled[block] = 1u;
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+/*************************************************************************
+ * DMALoopStart() - Hands playback over to a wavetable of 'len' samples
+ *  that the DMA repeats on its own. The table TCD links to itself through
+ *  scatter/gather, so once it is running there are no interrupts at all.
+ *  The link is armed on the current major loop, so the table starts right
+ *  after 'block', which must be the one playing. Returns FALSE if the DMA
+ *  has already left 'block' or is too close to its end.
+ *************************************************************************/
+INT8U DMALoopStart(const INT16U *table, INT16U len, INT8U block){
+    INT8U armed;
+    CPU_SR_ALLOC();
+
+    dmaLoopTcd = dmaStreamTcd;
+    dmaLoopTcd.saddr = (INT32U)table;
+    dmaLoopTcd.attr = (INT16U)(DMA_ATTR_SSIZE(SIZE_CODE_16BIT) | DMA_ATTR_DSIZE(SIZE_CODE_16BIT));
+    dmaLoopTcd.slast = -(INT32S)(len*WAVE_BYTES_PER_SAMPLE);
+    dmaLoopTcd.citer = (INT16U)DMA_CITER_ELINKNO_CITER(len);
+    dmaLoopTcd.biter = (INT16U)DMA_BITER_ELINKNO_BITER(len);
+    dmaLoopTcd.dlast_sga = (INT32U)&dmaLoopTcd;
+    dmaLoopTcd.csr = (INT16U)(DMA_CSR_ESG(1) | DMA_CSR_BWC(3));
+    dmaLoopActive = 0u;
+
+    //ESG has to be set well before the major loop ends, otherwise the
+    //ring would take DLAST_SGA as a destination adjustment.
+    CPU_CRITICAL_ENTER();
+    if((DMABlockPlaying() == block) &&
+       ((HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_CITER) & DMA_CITER_ELINKNO_CITER_MASK) >= DMA_LOOP_ARM_MIN)){
+        HalDmaDoneClear(WAVE_DMA_OUT_CH);
+        HalDmaTcdSet(WAVE_DMA_OUT_CH, HAL_TCD_DLAST_SGA, (INT32U)&dmaLoopTcd);
+        HalDmaTcdSet(WAVE_DMA_OUT_CH, HAL_TCD_CSR, HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_CSR) | DMA_CSR_ESG(1));
+        if((HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_CSR) & DMA_CSR_ESG_MASK) != 0){
+            armed = TRUE;
+        }else{
+            HalDmaTcdSet(WAVE_DMA_OUT_CH, HAL_TCD_DLAST_SGA, DMA_DLAST_SGA_DLASTSGA(0));
+            armed = FALSE;
+        }
+    }else{
+        armed = FALSE;
+    }
+    CPU_CRITICAL_EXIT();
+    return armed;
+}
+
+/*************************************************************************
+ * DMALoopExit() - Returns to block streaming. Every block must already
+ *  hold the samples that follow the table. The table finishes its current
+ *  pass and the ring starts at block [0], so the switch is seamless.
+ *************************************************************************/
+void DMALoopExit(void){
+    OS_ERR os_err;
+    INT8U block;
+
+    //The ring may still be playing out its last block before the loop
+    while(dmaLoopActive == 0u){
+        OSTimeDly(1, OS_OPT_TIME_DLY, &os_err);
+    }
+    dmaBlockRdy.index = DMA_RING_BLOCKS - 1u;
+    for(block = 0; block < DMA_RING_BLOCKS; block++){
+        dmaBlockFilled[block] = 1u;
+    }
+    (void)OSSemSet(&(dmaBlockRdy.flag), 0, &os_err);
+    while(os_err != OS_ERR_NONE){           /* Error Trap                  */
+    }
+    ProfileReleaseFlush(PROF_WAVE);
+    //Update both copies, the engine may be reloading the loop TCD right now
+    dmaLoopTcd.dlast_sga = (INT32U)&dmaStreamTcd;
+    HalDmaTcdSet(WAVE_DMA_OUT_CH, HAL_TCD_DLAST_SGA, (INT32U)&dmaStreamTcd);
+    dmaLoopActive = 0u;
+}
+
+/*************************************************************************
+ * DMATcdSave() - Copies the output channel's TCD registers to *tcd
+ *************************************************************************/
+static void DMATcdSave(DMA_TCD *tcd){
+    tcd->saddr = HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_SADDR);
+    tcd->soff = (INT16S)HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_SOFF);
+    tcd->attr = (INT16U)HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_ATTR);
+    tcd->nbytes = HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_NBYTES);
+    tcd->slast = (INT32S)HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_SLAST);
+    tcd->daddr = HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_DADDR);
+    tcd->doff = (INT16S)HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_DOFF);
+    tcd->citer = (INT16U)HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_CITER);
+    tcd->dlast_sga = HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_DLAST_SGA);
+    tcd->csr = (INT16U)HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_CSR);
+    tcd->biter = (INT16U)HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_BITER);
+}
+
+/*************************************************************************
+ * DMABlockPlaying() - Ring block the DMA is reading from, taken from the
+ *  channel's source address
+ *************************************************************************/
+static INT8U DMABlockPlaying(void){
+    return (INT8U)(((HalDmaTcdGet(WAVE_DMA_OUT_CH, HAL_TCD_SADDR) - dmaRingBase)/WAVE_BYTES_PER_BLOCK) % DMA_RING_BLOCKS);
+}
@@ -8,9 +8,32 @@
 #ifndef SOURCES_DMA_H_
 #define SOURCES_DMA_H_
 
+#define DMA_DAC_SAMPLE_RATE 48000u      //Requested DAC rate, TimebaseRateGet(TB_PIT_DAC) is exact
+
+/*****************************************************************************************
+* DAC block ring - the one place the output buffer size is defined
+* - One interrupt per block, DMA_DAC_SAMPLE_RATE/DMA_RING_BLOCK_SAMPLES per second.
+* - A block is written DMA_RING_BLOCKS-1 blocks ahead of the DMA, which is both the
+*   time WaveTask has before an underrun and the latency of a parameter change.
+*   Larger blocks cut the interrupt rate, more blocks add slack, both add latency.
+* - DMA_RING_BYTES must be a power of two, DMA_RING_SMOD = log2(DMA_RING_BYTES).
+*****************************************************************************************/
+#define DMA_RING_BLOCKS 4u
+#define DMA_RING_BLOCK_SAMPLES 256u
+#define DMA_RING_BYTES (DMA_RING_BLOCKS*DMA_RING_BLOCK_SAMPLES*2u)
+#define DMA_RING_SMOD 11u
+
+/* Underrun counters, see DMAStatsGet() */
+typedef struct{
+    INT32U blocks;          //Blocks played since the last reset
+    INT32U misses;          //Blocks played without being refilled since their last pass
+    INT32U min_slack;       //Fewest DAC samples left before a block was played, at fill time
+}DMA_STATS;
+
 /*****************************************************************************************
 * DMA Initializations
-* - Argument passed through is an address to the Wave ping-pong buffer.
+* - Argument passed through is the address of the Wave block ring, which must be
+*   aligned to DMA_RING_BYTES.
 * - DMA will transfer data to the DAC from the Wave block currently not being written to.
 *****************************************************************************************/
 void DMAInit(INT16U *wave_info_block);
@@ -18,7 +41,8 @@ void DMAInit(INT16U *wave_info_block);
 /*****************************************************************************************
 * DMA IRQ
 * - Posting dmaBlockRdy.flag tells WaveTask that the DMA is moving on to next block
-* - dmaBlockRdy.index tells WaveTask which block to currently write to.
+* - dmaBlockRdy.index tells WaveTask which block to currently write to, worked out
+*   from the DMA source address.
 *****************************************************************************************/
 void DMA0_DMA16_IRQHandler(void);
 
@@ -29,4 +53,34 @@ void DMA0_DMA16_IRQHandler(void);
  *************************************************************************/
 void DMAPend(INT8U *buffer_block);
 
+/*************************************************************************
+ * DMABlockDone() - WaveTask reports 'block' as written, for the underrun
+ *  check in the DMA IRQ and the slack record.
+ *************************************************************************/
+void DMABlockDone(INT8U block);
+
+/*************************************************************************
+ * DMAStatsGet() - Copies the underrun counters to *stats. A miss means
+ *  the DAC replayed a stale block, min_slack shows how close it came.
+ *************************************************************************/
+void DMAStatsGet(DMA_STATS *stats);
+
+/*************************************************************************
+ * DMAStatsReset() - Clears the underrun counters
+ *************************************************************************/
+void DMAStatsReset(void);
+
+/*************************************************************************
+ * DMALoopStart() - Arms the DMA to repeat 'table' of 'len' samples with no
+ *  CPU involvement, starting after 'block', the one now playing. FALSE if it
+ *  could not be armed in time, in which case streaming just continues.
+ *************************************************************************/
+INT8U DMALoopStart(const INT16U *table, INT16U len, INT8U block);
+
+/*************************************************************************
+ * DMALoopExit() - Switches back to block streaming at the end of the
+ *  current table pass. All blocks must be filled before calling.
+ *************************************************************************/
+void DMALoopExit(void);
+
 #endif /* SOURCES_DMA_H_ */
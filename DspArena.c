@@ -0,0 +1,59 @@
+/********************************************************************
+* DspArena.c - Static bump allocator for DSP scratch memory
+* Replaces the analyzer's global Input/Output arrays. Allocations
+* live until the next DspArenaReset(), so no stage ever frees
+* memory itself.
+* The arena is reset once per phase, not once per frame: the
+* analyzer keeps the same frame scratch for its whole life, so
+* ADCTask carves it once at start up and every frame reuses it
+* with no allocation at all.
+* Constant data such as window tables stay in flash and never
+* come out of the arena.
+*
+* agent, 10/18/2026
+********************************************************************/
+#include "MCUType.h"
+#include "DspArena.h"
+
+/* Compile-time check that the configured peak fits the RAM budget */
+typedef INT8U DSP_ARENA_SIZE_CHECK[(DSP_PEAK_BYTES <= DSP_ARENA_BUDGET_BYTES) ? 1 : -1];
+
+/*********************************************************************
+* Private Resources
+********************************************************************/
+//FP64 forces 8 byte alignment, own section so the map shows its size
+static FP64 dspArena[DSP_ARENA_BYTES/sizeof(FP64)] __attribute__((section(".bss.dspArena")));
+static INT32U dspArenaUsed = 0;
+static INT32U dspArenaPeak = 0;
+
+/******************************************************************************
+ * DspArenaReset() - Releases every allocation
+ ******************************************************************************/
+void DspArenaReset(void){
+    dspArenaUsed = 0;
+}
+
+/******************************************************************************
+ * DspArenaAlloc() - Bumps the arena pointer by 'bytes' rounded up to the
+ *  arena alignment and returns the old position.
+ ******************************************************************************/
+void *DspArenaAlloc(INT32U bytes){
+    INT8U *block;
+
+    bytes = (bytes + (DSP_ARENA_ALIGN - 1u)) & ~(DSP_ARENA_ALIGN - 1u);
+    while((dspArenaUsed + bytes) > DSP_ARENA_BYTES){}     //Error Trap, arena exhausted
+
+    block = (INT8U *)dspArena + dspArenaUsed;
+    dspArenaUsed = dspArenaUsed + bytes;
+    if(dspArenaUsed > dspArenaPeak){
+        dspArenaPeak = dspArenaUsed;
+    } else{}
+    return block;
+}
+
+/******************************************************************************
+ * DspArenaPeak() - Returns the high water mark of the arena in bytes
+ ******************************************************************************/
+INT32U DspArenaPeak(void){
+    return dspArenaPeak;
+}
@@ -0,0 +1,57 @@
+/********************************************************************
+* DspArena.h - Header file for the DSP scratch arena module
+* All DSP scratch buffers are carved out of one static arena, in two
+* phases. During init WaveTableInit() borrows it to build the
+* wavetable levels. ADCTask then resets it and carves the analyzer's
+* frame scratch and its loopback hop once at start up. Stages that
+* can work in place share the same memory instead of each owning a
+* global array.
+*
+* agent, 10/18/2026
+********************************************************************/
+#ifndef DSPARENA_H_
+#define DSPARENA_H_
+
+/*********************************************************************
+* Analyzer configuration - everything the scratch size depends on
+********************************************************************/
+#define DSP_FFT_SIZE 1024           //Real samples per frame. 44100/1024 = 43Hz resolution
+#define DSP_HOP_SIZE (DSP_FFT_SIZE/4u)  //Samples between frame starts, DSP_FFT_SIZE = no overlap
+#define DSP_FFT_BUF_WORDS DSP_FFT_SIZE          //Real FFT input frame
+#define DSP_SPEC_WORDS DSP_FFT_SIZE             //Packed real FFT output, N/2 complex bins
+#define DSP_STAGE_WORDS (DSP_HOP_SIZE/2u)       //One hop of raw INT16U loopback samples
+#define DSP_MAG_WORDS 0u            //Magnitudes are written over the FFT input frame
+
+#define DSP_WT_WORDS (3u*512u)      //Wavetable spectrum, work and time buffers, init only
+
+/* Peak scratch use for the current configuration: the larger of the two
+ * phases, each summed over the stages that are live at the same time */
+#define DSP_FRAME_WORDS (DSP_FFT_BUF_WORDS + DSP_SPEC_WORDS + DSP_STAGE_WORDS + DSP_MAG_WORDS)
+#define DSP_PEAK_WORDS ((DSP_FRAME_WORDS > DSP_WT_WORDS) ? DSP_FRAME_WORDS : DSP_WT_WORDS)
+#define DSP_PEAK_BYTES (DSP_PEAK_WORDS*4u)
+
+#define DSP_ARENA_ALIGN 8u                          //Alignment of every allocation
+#define DSP_ARENA_BYTES DSP_PEAK_BYTES              //Arena is sized to the peak exactly
+#define DSP_ARENA_BUDGET_BYTES 12288u               //RAM set aside for DSP scratch
+
+/* The peak in bytes for a build is the size of section .bss.dspArena in
+ * the linker map, and DspArenaPeak() gives what was carved at run time.
+ * A configuration that outgrows DSP_ARENA_BUDGET_BYTES fails to compile. */
+
+/******************************************************************************
+ * DspArenaReset() - Releases every allocation
+ ******************************************************************************/
+void DspArenaReset(void);
+
+/******************************************************************************
+ * DspArenaAlloc() - Returns DSP_ARENA_ALIGN aligned scratch of 'bytes' length.
+ *  Traps if the arena is exhausted, which means DSP_PEAK_WORDS is wrong.
+ ******************************************************************************/
+void *DspArenaAlloc(INT32U bytes);
+
+/******************************************************************************
+ * DspArenaPeak() - Returns the high water mark of the arena in bytes
+ ******************************************************************************/
+INT32U DspArenaPeak(void);
+
+#endif
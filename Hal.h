@@ -0,0 +1,305 @@
+/********************************************************************
+* Hal.h - Peripheral register access layer
+* Every register the drivers read or write goes through the
+* functions below instead of the MK65F18.h register macros. On the
+* target they are static inline, so with constant arguments the
+* compiler can reduce a call to a direct register access. The code
+* size has not been compared with the direct accesses. Drivers make
+* the same register writes, in the same order, as before the layer,
+* except that PSOR, which reads as zero, is written instead of ORed.
+* Bit field macros such as ADC_SC1_COCO_MASK still come from
+* MK65F18.h, they are plain constants. There is no host build, so
+* the layer only has the target implementation.
+* Covers SIM clock gates, PORT pin control, GPIO, PIT, ADC0, DAC0,
+* VREF, TSI0, the eDMA/DMAMUX channel registers, the NVIC and the
+* DWT cycle counter.
+*
+* agent, 10/18/2026
+********************************************************************/
+#ifndef HAL_H_
+#define HAL_H_
+
+typedef enum{HAL_PORTA, HAL_PORTB, HAL_PORTC, HAL_PORTD} HAL_PORT;
+typedef enum{HAL_SCGC2, HAL_SCGC5, HAL_SCGC6, HAL_SCGC7} HAL_GATE;
+
+//eDMA transfer control descriptor fields
+typedef enum{
+    HAL_TCD_SADDR,
+    HAL_TCD_SOFF,
+    HAL_TCD_ATTR,
+    HAL_TCD_NBYTES,
+    HAL_TCD_SLAST,
+    HAL_TCD_DADDR,
+    HAL_TCD_DOFF,
+    HAL_TCD_CITER,
+    HAL_TCD_DLAST_SGA,
+    HAL_TCD_CSR,
+    HAL_TCD_BITER
+} HAL_TCD_FIELD;
+
+/* GPIO registers of one port, in memory order */
+typedef struct{
+    INT32U pdor;
+    INT32U psor;
+    INT32U pcor;
+    INT32U ptor;
+    INT32U pdir;
+    INT32U pddr;
+} HAL_GPIO_REGS;
+
+static inline volatile HAL_GPIO_REGS *halGpio(HAL_PORT port){
+    volatile INT32U *pdor;
+    switch(port){
+    case HAL_PORTA: pdor = (volatile INT32U *)&GPIOA_PDOR; break;
+    case HAL_PORTB: pdor = (volatile INT32U *)&GPIOB_PDOR; break;
+    case HAL_PORTC: pdor = (volatile INT32U *)&GPIOC_PDOR; break;
+    default: pdor = (volatile INT32U *)&GPIOD_PDOR; break;
+    }
+    return (volatile HAL_GPIO_REGS *)pdor;
+}
+
+/* PCR0 to PCR31 are contiguous */
+static inline volatile INT32U *halPcr(HAL_PORT port, INT8U pin){
+    volatile INT32U *pcr;
+    switch(port){
+    case HAL_PORTA: pcr = (volatile INT32U *)&PORTA_PCR0; break;
+    case HAL_PORTB: pcr = (volatile INT32U *)&PORTB_PCR0; break;
+    case HAL_PORTC: pcr = (volatile INT32U *)&PORTC_PCR0; break;
+    default: pcr = (volatile INT32U *)&PORTD_PCR0; break;
+    }
+    return &pcr[pin];
+}
+
+/******************************************************************************
+ * SIM - clock gates and the ADC trigger select
+ ******************************************************************************/
+static inline void HalGateSet(HAL_GATE gate, INT32U mask){
+    switch(gate){
+    case HAL_SCGC2: SIM_SCGC2 |= mask; break;
+    case HAL_SCGC5: SIM_SCGC5 |= mask; break;
+    case HAL_SCGC6: SIM_SCGC6 |= mask; break;
+    default: SIM_SCGC7 |= mask; break;
+    }
+}
+static inline void HalAdcTrigSet(INT32U sopt7){
+    SIM_SOPT7 |= sopt7;
+}
+
+/******************************************************************************
+ * PORT - pin control and interrupt status
+ ******************************************************************************/
+static inline void HalPinCfgSet(HAL_PORT port, INT8U pin, INT32U pcr){
+    *halPcr(port, pin) = pcr;
+}
+static inline INT32U HalPinCfgGet(HAL_PORT port, INT8U pin){
+    return *halPcr(port, pin);
+}
+static inline INT32U HalPinIsfGet(HAL_PORT port){
+    INT32U isfr;
+
+    switch(port){
+    case HAL_PORTA: isfr = PORTA_ISFR; break;
+    case HAL_PORTB: isfr = PORTB_ISFR; break;
+    case HAL_PORTC: isfr = PORTC_ISFR; break;
+    default: isfr = PORTD_ISFR; break;
+    }
+    return isfr;
+}
+static inline void HalPinIsfClear(HAL_PORT port, INT32U pins){
+    switch(port){
+    case HAL_PORTA: PORTA_ISFR = pins; break;
+    case HAL_PORTB: PORTB_ISFR = pins; break;
+    case HAL_PORTC: PORTC_ISFR = pins; break;
+    default: PORTD_ISFR = pins; break;
+    }
+}
+
+/******************************************************************************
+ * GPIO
+ ******************************************************************************/
+static inline void HalGpioSet(HAL_PORT port, INT32U pins){
+    halGpio(port)->psor = pins;
+}
+static inline void HalGpioClear(HAL_PORT port, INT32U pins){
+    halGpio(port)->pcor = pins;
+}
+static inline void HalGpioToggle(HAL_PORT port, INT32U pins){
+    halGpio(port)->ptor = pins;
+}
+static inline void HalGpioOutSet(HAL_PORT port, INT32U value){
+    halGpio(port)->pdor = value;
+}
+static inline INT32U HalGpioOutGet(HAL_PORT port){
+    return halGpio(port)->pdor;
+}
+static inline INT32U HalGpioInGet(HAL_PORT port){
+    return halGpio(port)->pdir;
+}
+static inline void HalGpioDirSet(HAL_PORT port, INT32U value){
+    halGpio(port)->pddr = value;
+}
+static inline INT32U HalGpioDirGet(HAL_PORT port){
+    return halGpio(port)->pddr;
+}
+
+/******************************************************************************
+ * PIT
+ ******************************************************************************/
+static inline void HalPitEnable(void){
+    PIT_MCR &= ~PIT_MCR_MDIS_MASK;
+}
+static inline void HalPitLoadSet(INT8U ch, INT32U ldval){
+    PIT_LDVAL(ch) = ldval;
+}
+static inline void HalPitRun(INT8U ch, INT8U run){
+    if(run != FALSE){
+        PIT_TCTRL(ch) |= PIT_TCTRL_TEN_MASK;
+    }else{
+        PIT_TCTRL(ch) &= ~PIT_TCTRL_TEN_MASK;
+    }
+}
+static inline void HalPitIrqEnable(INT8U ch){
+    PIT_TCTRL(ch) |= PIT_TCTRL_TIE_MASK;
+}
+static inline void HalPitFlagClear(INT8U ch){
+    PIT_TFLG(ch) |= PIT_TFLG_TIF_MASK;
+}
+
+/******************************************************************************
+ * ADC0
+ ******************************************************************************/
+static inline void HalAdcCfg1Set(INT32U cfg1){
+    ADC0_CFG1 = cfg1;
+}
+static inline void HalAdcCfg2Set(INT32U cfg2){
+    ADC0_CFG2 = cfg2;
+}
+static inline void HalAdcSc2Set(INT32U sc2){
+    ADC0_SC2 = sc2;
+}
+static inline void HalAdcSc3Set(INT32U sc3){
+    ADC0_SC3 = sc3;
+}
+static inline INT32U HalAdcSc3Get(void){
+    return ADC0_SC3;
+}
+static inline void HalAdcChanSet(INT32U sc1){
+    ADC0_SC1A = sc1;
+}
+static inline INT32U HalAdcDone(void){
+    return ADC0_SC1A & ADC_SC1_COCO_MASK;
+}
+static inline INT32U HalAdcResult(void){
+    return ADC0_RA;
+}
+
+/******************************************************************************
+ * VREF and DAC0
+ ******************************************************************************/
+static inline void HalVrefSet(INT32U sc){
+    VREF_SC = sc;
+}
+static inline void HalDacCfgSet(INT32U c0, INT32U c1){
+    DAC0_C0 = c0;
+    DAC0_C1 = c1;
+}
+static inline INT32U HalDacDataAddr(void){
+    return (INT32U)&DAC0_DAT0L;
+}
+
+/******************************************************************************
+ * eDMA and DMAMUX
+ ******************************************************************************/
+static inline void HalDmaMuxSet(INT8U ch, INT32U chcfg){
+    DMAMUX_CHCFG(ch) = chcfg;
+}
+static inline INT32U HalDmaMuxGet(INT8U ch){
+    return DMAMUX_CHCFG(ch);
+}
+static inline void HalDmaTcdSet(INT8U ch, HAL_TCD_FIELD field, INT32U value){
+    switch(field){
+    case HAL_TCD_SADDR: DMA_SADDR(ch) = value; break;
+    case HAL_TCD_SOFF: DMA_SOFF(ch) = value; break;
+    case HAL_TCD_ATTR: DMA_ATTR(ch) = value; break;
+    case HAL_TCD_NBYTES: DMA_NBYTES_MLNO(ch) = value; break;
+    case HAL_TCD_SLAST: DMA_SLAST(ch) = value; break;
+    case HAL_TCD_DADDR: DMA_DADDR(ch) = value; break;
+    case HAL_TCD_DOFF: DMA_DOFF(ch) = value; break;
+    case HAL_TCD_CITER: DMA_CITER_ELINKNO(ch) = value; break;
+    case HAL_TCD_DLAST_SGA: DMA_DLAST_SGA(ch) = value; break;
+    case HAL_TCD_CSR: DMA_CSR(ch) = value; break;
+    default: DMA_BITER_ELINKNO(ch) = value; break;
+    }
+}
+static inline INT32U HalDmaTcdGet(INT8U ch, HAL_TCD_FIELD field){
+    INT32U value;
+    switch(field){
+    case HAL_TCD_SADDR: value = DMA_SADDR(ch); break;
+    case HAL_TCD_SOFF: value = DMA_SOFF(ch); break;
+    case HAL_TCD_ATTR: value = DMA_ATTR(ch); break;
+    case HAL_TCD_NBYTES: value = DMA_NBYTES_MLNO(ch); break;
+    case HAL_TCD_SLAST: value = DMA_SLAST(ch); break;
+    case HAL_TCD_DADDR: value = DMA_DADDR(ch); break;
+    case HAL_TCD_DOFF: value = DMA_DOFF(ch); break;
+    case HAL_TCD_CITER: value = DMA_CITER_ELINKNO(ch); break;
+    case HAL_TCD_DLAST_SGA: value = DMA_DLAST_SGA(ch); break;
+    case HAL_TCD_CSR: value = DMA_CSR(ch); break;
+    default: value = DMA_BITER_ELINKNO(ch); break;
+    }
+    return value;
+}
+static inline void HalDmaReqEnable(INT8U ch){
+    DMA_SERQ = DMA_SERQ_SERQ(ch);
+}
+static inline void HalDmaIntClear(INT8U ch){
+    DMA_CINT = DMA_CINT_CINT(ch);
+}
+static inline void HalDmaDoneClear(INT8U ch){
+    DMA_CDNE = DMA_CDNE_CDNE(ch);
+}
+
+/******************************************************************************
+ * TSI0 - HalTsiScan() selects a channel and starts a software scan
+ ******************************************************************************/
+static inline void HalTsiCfgSet(INT32U gencs){
+    TSI0_GENCS = gencs;
+}
+static inline INT32U HalTsiCfgGet(void){
+    return TSI0_GENCS;
+}
+static inline void HalTsiScan(INT8U chan){
+    TSI0_DATA = TSI_DATA_TSICH(chan);
+    TSI0_DATA |= TSI_DATA_SWTS(1);
+}
+static inline INT32U HalTsiScanDone(void){
+    return TSI0_GENCS & TSI_GENCS_EOSF_MASK;
+}
+static inline void HalTsiScanDoneClear(void){
+    TSI0_GENCS |= TSI_GENCS_EOSF(1);
+}
+static inline INT16U HalTsiCount(void){
+    return (INT16U)(TSI0_DATA & TSI_DATA_TSICNT_MASK);
+}
+
+/******************************************************************************
+ * NVIC
+ ******************************************************************************/
+static inline void HalIrqEnable(IRQn_Type irq){
+    NVIC_EnableIRQ(irq);
+}
+static inline void HalIrqPendClear(IRQn_Type irq){
+    NVIC_ClearPendingIRQ(irq);
+}
+
+/******************************************************************************
+ * DWT - free running core cycle counter, wraps every 2^32 cycles
+ ******************************************************************************/
+static inline void HalCycleCountStart(void){
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+static inline INT32U HalCycleCount(void){
+    return DWT->CYCCNT;
+}
+
+#endif
@@ -3,8 +3,10 @@
 * Todd Morton, 10/08/2015
 * Todd Morton, 11/25/2015 Modified for new Debug bits. See EE344, Lab5, 2015
 * Todd Morton, 10/16/2017 Modified to remove includes.h
+* 10/18/2026 Register access moved to Hal.h
  ****************************************************************************************/
 #include "MCUType.h"
+#include "Hal.h"
 #include "K65TWR_GPIO.h"
 
 /*****************************************************************************************
@@ -26,8 +28,8 @@
  ****************************************************************************************/
 void GpioSw3Init(INT8U irqc){
 
-    SIM_SCGC5 |= SIM_SCGC5_PORTA_MASK; /* Enable clock gate for PORTA */
-    PORTA_PCR10 = PORT_PCR_MUX(1)|PORT_PCR_PE(1)|PORT_PCR_PS(1)|PORT_PCR_IRQC(irqc);
+    HalGateSet(HAL_SCGC5, SIM_SCGC5_PORTA_MASK); /* Enable clock gate for PORTA */
+    HalPinCfgSet(HAL_PORTA, 10, PORT_PCR_MUX(1)|PORT_PCR_PE(1)|PORT_PCR_PS(1)|PORT_PCR_IRQC(irqc));
 }
 
 /*****************************************************************************************
@@ -48,8 +50,8 @@ void GpioSw3Init(INT8U irqc){
 * 10/16/2017, TDM
  ****************************************************************************************/
 void GpioSw2Init(INT8U irqc){
-    SIM_SCGC5 |= SIM_SCGC5_PORTA_MASK; /* Enable clock gate for PORTA */
-    PORTA_PCR4 = PORT_PCR_MUX(1)|PORT_PCR_PE(1)|PORT_PCR_PS(1)|PORT_PCR_IRQC(irqc);
+    HalGateSet(HAL_SCGC5, SIM_SCGC5_PORTA_MASK); /* Enable clock gate for PORTA */
+    HalPinCfgSet(HAL_PORTA, 4, PORT_PCR_MUX(1)|PORT_PCR_PE(1)|PORT_PCR_PS(1)|PORT_PCR_IRQC(irqc));
 }
 
 /*****************************************************************************************
@@ -58,10 +60,10 @@ void GpioSw2Init(INT8U irqc){
  ****************************************************************************************/
 void GpioLED8Init(void){
 
-    SIM_SCGC5 |= SIM_SCGC5_PORTA_MASK; /* Enable clock gate for PORTA */
-    PORTA_PCR28 = PORT_PCR_MUX(1);
-    GPIOA_PSOR |= GPIO_PIN(LED8_BIT);     /* Initialize off, activelow */
-    GPIOA_PDDR |= GPIO_PIN(LED8_BIT);
+    HalGateSet(HAL_SCGC5, SIM_SCGC5_PORTA_MASK); /* Enable clock gate for PORTA */
+    HalPinCfgSet(HAL_PORTA, 28, PORT_PCR_MUX(1));
+    HalGpioSet(HAL_PORTA, GPIO_PIN(LED8_BIT));     /* Initialize off, activelow */
+    HalGpioDirSet(HAL_PORTA, HalGpioDirGet(HAL_PORTA) | GPIO_PIN(LED8_BIT));
 }
 
 /*****************************************************************************************
@@ -70,29 +72,29 @@ void GpioLED8Init(void){
  ****************************************************************************************/
 void GpioLED9Init(void){
 
-    SIM_SCGC5 |= SIM_SCGC5_PORTA_MASK; /* Enable clock gate for PORTA */
-    PORTA_PCR29 = PORT_PCR_MUX(1);
-    GPIOA_PSOR |= GPIO_PIN(LED9_BIT);     /* Initialize off, activelow */
-    GPIOA_PDDR |= GPIO_PIN(LED9_BIT);
+    HalGateSet(HAL_SCGC5, SIM_SCGC5_PORTA_MASK); /* Enable clock gate for PORTA */
+    HalPinCfgSet(HAL_PORTA, 29, PORT_PCR_MUX(1));
+    HalGpioSet(HAL_PORTA, GPIO_PIN(LED9_BIT));     /* Initialize off, activelow */
+    HalGpioDirSet(HAL_PORTA, HalGpioDirGet(HAL_PORTA) | GPIO_PIN(LED9_BIT));
 }
 /*****************************************************************************************
 * GpioDBugBitsInit - Initialization for Debug bits, each bit is cleared to 0.
 * 10/16/2017, TDM
  ****************************************************************************************/
 void GpioDBugBitsInit(void){
-    SIM_SCGC5 |= SIM_SCGC5_PORTB(1);
-    SIM_SCGC5 |= SIM_SCGC5_PORTC(1);
-    PORTC_PCR15 = PORT_PCR_MUX(1);
-    PORTC_PCR14 = PORT_PCR_MUX(1);
-    PORTC_PCR13 = PORT_PCR_MUX(1);
-    PORTC_PCR12 = PORT_PCR_MUX(1);
-    PORTB_PCR23 = PORT_PCR_MUX(1);
-    PORTB_PCR22 = PORT_PCR_MUX(1);
-    PORTB_PCR21 = PORT_PCR_MUX(1);
-    PORTB_PCR20 = PORT_PCR_MUX(1);
-    GPIOC_PCOR = GPIO_PIN(DB0_BIT)|GPIO_PIN(DB1_BIT)|GPIO_PIN(DB2_BIT)|GPIO_PIN(DB3_BIT);
-    GPIOB_PCOR = GPIO_PIN(DB4_BIT)|GPIO_PIN(DB5_BIT)|GPIO_PIN(DB6_BIT)|GPIO_PIN(DB7_BIT);
-    GPIOC_PDDR = GPIO_PIN(DB0_BIT)|GPIO_PIN(DB1_BIT)|GPIO_PIN(DB2_BIT)|GPIO_PIN(DB3_BIT);
-    GPIOB_PDDR = GPIO_PIN(DB4_BIT)|GPIO_PIN(DB5_BIT)|GPIO_PIN(DB6_BIT)|GPIO_PIN(DB7_BIT);
+    HalGateSet(HAL_SCGC5, SIM_SCGC5_PORTB(1));
+    HalGateSet(HAL_SCGC5, SIM_SCGC5_PORTC(1));
+    HalPinCfgSet(HAL_PORTC, 15, PORT_PCR_MUX(1));
+    HalPinCfgSet(HAL_PORTC, 14, PORT_PCR_MUX(1));
+    HalPinCfgSet(HAL_PORTC, 13, PORT_PCR_MUX(1));
+    HalPinCfgSet(HAL_PORTC, 12, PORT_PCR_MUX(1));
+    HalPinCfgSet(HAL_PORTB, 23, PORT_PCR_MUX(1));
+    HalPinCfgSet(HAL_PORTB, 22, PORT_PCR_MUX(1));
+    HalPinCfgSet(HAL_PORTB, 21, PORT_PCR_MUX(1));
+    HalPinCfgSet(HAL_PORTB, 20, PORT_PCR_MUX(1));
+    HalGpioClear(HAL_PORTC, GPIO_PIN(DB0_BIT)|GPIO_PIN(DB1_BIT)|GPIO_PIN(DB2_BIT)|GPIO_PIN(DB3_BIT));
+    HalGpioClear(HAL_PORTB, GPIO_PIN(DB4_BIT)|GPIO_PIN(DB5_BIT)|GPIO_PIN(DB6_BIT)|GPIO_PIN(DB7_BIT));
+    HalGpioDirSet(HAL_PORTC, GPIO_PIN(DB0_BIT)|GPIO_PIN(DB1_BIT)|GPIO_PIN(DB2_BIT)|GPIO_PIN(DB3_BIT));
+    HalGpioDirSet(HAL_PORTB, GPIO_PIN(DB4_BIT)|GPIO_PIN(DB5_BIT)|GPIO_PIN(DB6_BIT)|GPIO_PIN(DB7_BIT));
 }
 
@@ -2,6 +2,7 @@
 * K65TWR_GPIO.h - K65TWR GPIO support package
 * Todd Morton, 10/08/2015
 * Todd Morton, 11/25/2015 Modified for new Debug bits. See EE344, Lab5, 2015
+* 10/18/2026 Register access moved to Hal.h, which must be included first
 ****************************************************************************************/
 
 #ifndef GPIO_H_
@@ -23,24 +24,24 @@ void GpioDBugBitsInit(void);
 #define LED8_BIT 28U
 #define LED9_BIT 29U
 
-#define LED8_TURN_OFF()  (GPIOA_PSOR = GPIO_PIN(LED8_BIT))
-#define LED8_TURN_ON() (GPIOA_PCOR = GPIO_PIN(LED8_BIT))
-#define LED8_TOGGLE() (GPIOA_PTOR = GPIO_PIN(LED8_BIT))
+#define LED8_TURN_OFF()  HalGpioSet(HAL_PORTA, GPIO_PIN(LED8_BIT))
+#define LED8_TURN_ON() HalGpioClear(HAL_PORTA, GPIO_PIN(LED8_BIT))
+#define LED8_TOGGLE() HalGpioToggle(HAL_PORTA, GPIO_PIN(LED8_BIT))
 
-#define LED9_TURN_OFF()  (GPIOA_PSOR = GPIO_PIN(LED9_BIT))
-#define LED9_TURN_ON() (GPIOA_PCOR = GPIO_PIN(LED9_BIT))
-#define LED9_TOGGLE() (GPIOA_PTOR = GPIO_PIN(LED9_BIT))
+#define LED9_TURN_OFF()  HalGpioSet(HAL_PORTA, GPIO_PIN(LED9_BIT))
+#define LED9_TURN_ON() HalGpioClear(HAL_PORTA, GPIO_PIN(LED9_BIT))
+#define LED9_TOGGLE() HalGpioToggle(HAL_PORTA, GPIO_PIN(LED9_BIT))
 
 #define SW2_BIT 4U
 #define SW3_BIT 10U
-#define SW2_INPUT (GPIOA_PDIR & GPIO_PIN(SW2_BIT))
-#define SW3_INPUT (GPIOA_PDIR & GPIO_PIN(SW3_BIT))
+#define SW2_INPUT (HalGpioInGet(HAL_PORTA) & GPIO_PIN(SW2_BIT))
+#define SW3_INPUT (HalGpioInGet(HAL_PORTA) & GPIO_PIN(SW3_BIT))
 
-#define SW2_ISF (PORTA_ISFR & GPIO_PIN(SW2_BIT))
+#define SW2_ISF (HalPinIsfGet(HAL_PORTA) & GPIO_PIN(SW2_BIT))
 
-#define SW2_INIT_INT() (PORTA_PCR26=PORT_PCR_MUX(1)|PORT_PCR_PE_MASK|\
+#define SW2_INIT_INT() HalPinCfgSet(HAL_PORTA, 26, PORT_PCR_MUX(1)|PORT_PCR_PE_MASK|\
     PORT_PCR_PS_MASK|PORT_PCR_IRQC(9))
-#define SW2_CLR_ISF() (PORTA_ISFR = GPIO_PIN(SW2_BIT))
+#define SW2_CLR_ISF() HalPinIsfClear(HAL_PORTA, GPIO_PIN(SW2_BIT))
 
 /****************************************************************************************
  * #defines for debug bits
@@ -54,30 +55,30 @@ void GpioDBugBitsInit(void);
 #define DB6_BIT 21
 #define DB7_BIT 20
 
-#define DB0_TURN_ON() (GPIOC_PSOR = GPIO_PIN(DB0_BIT))
-#define DB1_TURN_ON() (GPIOC_PSOR = GPIO_PIN(DB1_BIT))
-#define DB2_TURN_ON() (GPIOC_PSOR = GPIO_PIN(DB2_BIT))
-#define DB3_TURN_ON() (GPIOC_PSOR = GPIO_PIN(DB3_BIT))
-#define DB4_TURN_ON() (GPIOB_PSOR = GPIO_PIN(DB4_BIT))
-#define DB5_TURN_ON() (GPIOB_PSOR = GPIO_PIN(DB5_BIT))
-#define DB6_TURN_ON() (GPIOB_PSOR = GPIO_PIN(DB6_BIT))
-#define DB7_TURN_ON() (GPIOB_PSOR = GPIO_PIN(DB7_BIT))
+#define DB0_TURN_ON() HalGpioSet(HAL_PORTC, GPIO_PIN(DB0_BIT))
+#define DB1_TURN_ON() HalGpioSet(HAL_PORTC, GPIO_PIN(DB1_BIT))
+#define DB2_TURN_ON() HalGpioSet(HAL_PORTC, GPIO_PIN(DB2_BIT))
+#define DB3_TURN_ON() HalGpioSet(HAL_PORTC, GPIO_PIN(DB3_BIT))
+#define DB4_TURN_ON() HalGpioSet(HAL_PORTB, GPIO_PIN(DB4_BIT))
+#define DB5_TURN_ON() HalGpioSet(HAL_PORTB, GPIO_PIN(DB5_BIT))
+#define DB6_TURN_ON() HalGpioSet(HAL_PORTB, GPIO_PIN(DB6_BIT))
+#define DB7_TURN_ON() HalGpioSet(HAL_PORTB, GPIO_PIN(DB7_BIT))
 
-#define DB0_TURN_OFF() (GPIOC_PCOR = GPIO_PIN(DB0_BIT))
-#define DB1_TURN_OFF() (GPIOC_PCOR = GPIO_PIN(DB1_BIT))
-#define DB2_TURN_OFF() (GPIOC_PCOR = GPIO_PIN(DB2_BIT))
-#define DB3_TURN_OFF() (GPIOC_PCOR = GPIO_PIN(DB3_BIT))
-#define DB4_TURN_OFF() (GPIOB_PCOR = GPIO_PIN(DB4_BIT))
-#define DB5_TURN_OFF() (GPIOB_PCOR = GPIO_PIN(DB5_BIT))
-#define DB6_TURN_OFF() (GPIOB_PCOR = GPIO_PIN(DB6_BIT))
-#define DB7_TURN_OFF() (GPIOB_PCOR = GPIO_PIN(DB7_BIT))
+#define DB0_TURN_OFF() HalGpioClear(HAL_PORTC, GPIO_PIN(DB0_BIT))
+#define DB1_TURN_OFF() HalGpioClear(HAL_PORTC, GPIO_PIN(DB1_BIT))
+#define DB2_TURN_OFF() HalGpioClear(HAL_PORTC, GPIO_PIN(DB2_BIT))
+#define DB3_TURN_OFF() HalGpioClear(HAL_PORTC, GPIO_PIN(DB3_BIT))
+#define DB4_TURN_OFF() HalGpioClear(HAL_PORTB, GPIO_PIN(DB4_BIT))
+#define DB5_TURN_OFF() HalGpioClear(HAL_PORTB, GPIO_PIN(DB5_BIT))
+#define DB6_TURN_OFF() HalGpioClear(HAL_PORTB, GPIO_PIN(DB6_BIT))
+#define DB7_TURN_OFF() HalGpioClear(HAL_PORTB, GPIO_PIN(DB7_BIT))
 
-#define DB0_TOGGLE() (GPIOC_PTOR = GPIO_PIN(DB0_BIT))
-#define DB1_TOGGLE() (GPIOC_PTOR = GPIO_PIN(DB1_BIT))
-#define DB2_TOGGLE() (GPIOC_PTOR = GPIO_PIN(DB2_BIT))
-#define DB3_TOGGLE() (GPIOC_PTOR = GPIO_PIN(DB3_BIT))
-#define DB4_TOGGLE() (GPIOB_PTOR = GPIO_PIN(DB4_BIT))
-#define DB5_TOGGLE() (GPIOB_PTOR = GPIO_PIN(DB5_BIT))
-#define DB6_TOGGLE() (GPIOB_PTOR = GPIO_PIN(DB6_BIT))
-#define DB7_TOGGLE() (GPIOB_PTOR = GPIO_PIN(DB7_BIT))
+#define DB0_TOGGLE() HalGpioToggle(HAL_PORTC, GPIO_PIN(DB0_BIT))
+#define DB1_TOGGLE() HalGpioToggle(HAL_PORTC, GPIO_PIN(DB1_BIT))
+#define DB2_TOGGLE() HalGpioToggle(HAL_PORTC, GPIO_PIN(DB2_BIT))
+#define DB3_TOGGLE() HalGpioToggle(HAL_PORTC, GPIO_PIN(DB3_BIT))
+#define DB4_TOGGLE() HalGpioToggle(HAL_PORTB, GPIO_PIN(DB4_BIT))
+#define DB5_TOGGLE() HalGpioToggle(HAL_PORTB, GPIO_PIN(DB5_BIT))
+#define DB6_TOGGLE() HalGpioToggle(HAL_PORTB, GPIO_PIN(DB6_BIT))
+#define DB7_TOGGLE() HalGpioToggle(HAL_PORTB, GPIO_PIN(DB7_BIT))
 #endif /* DBUGBITS_H_ */
@@ -19,6 +19,7 @@
 * 02/03/2016, More cleanup. TDM
 * 01/13/2017 Changed name to LcdLayered (was LayeredLcd), fixed bugs. TDM
 * 01/18/2018 Changed to replace includes.h TDM
+* 10/18/2026 Register access moved to Hal.h
 *****************************************************************************************
 * Header Files - Dependencies
 *****************************************************************************************/
@@ -26,6 +27,7 @@
 #include "app_cfg.h"
 #include "os.h"
 #include "LcdLayered.h"
+#include "Hal.h"
 #include "K65TWR_GPIO.h"
 
 /*****************************************************************************************
@@ -34,14 +36,13 @@
 #define LCD_RS_BIT     0x2
 #define LCD_E_BIT      0x4
 #define LCD_DB_MASK    0x78
-#define LCD_PORT       GPIOD_PDOR
-#define LCD_PORT_DIR   GPIOD_PDDR
-#define INIT_BIT_DIR() (LCD_PORT_DIR |= (LCD_RS_BIT|LCD_E_BIT|LCD_DB_MASK))
-#define LCD_SET_RS()   GPIOD_PSOR = LCD_RS_BIT
-#define LCD_CLR_RS()   GPIOD_PCOR = LCD_RS_BIT
-#define LCD_SET_E()    GPIOD_PSOR = LCD_E_BIT
-#define LCD_CLR_E()    GPIOD_PCOR = LCD_E_BIT
-#define LCD_WR_DB(nib) (GPIOD_PDOR = (GPIOD_PDOR & ~LCD_DB_MASK)|((nib)<<3))
+#define LCD_PORT       HAL_PORTD
+#define INIT_BIT_DIR() HalGpioDirSet(LCD_PORT, HalGpioDirGet(LCD_PORT)|LCD_RS_BIT|LCD_E_BIT|LCD_DB_MASK)
+#define LCD_SET_RS()   HalGpioSet(LCD_PORT, LCD_RS_BIT)
+#define LCD_CLR_RS()   HalGpioClear(LCD_PORT, LCD_RS_BIT)
+#define LCD_SET_E()    HalGpioSet(LCD_PORT, LCD_E_BIT)
+#define LCD_CLR_E()    HalGpioClear(LCD_PORT, LCD_E_BIT)
+#define LCD_WR_DB(nib) HalGpioOutSet(LCD_PORT, (HalGpioOutGet(LCD_PORT) & ~LCD_DB_MASK)|((nib)<<3))
 
 
 /*****************************************************************************************
@@ -526,13 +527,13 @@ void LcdInit(void) {
     }
 
     // Perform LCD hardware initialisation
-    SIM_SCGC5 |= SIM_SCGC5_PORTD_MASK;              /* Enable clock gate for PORTD */
-    PORTD_PCR1=(0|PORT_PCR_MUX(1));
-    PORTD_PCR2=(0|PORT_PCR_MUX(1));
-    PORTD_PCR3=(0|PORT_PCR_MUX(1));
-    PORTD_PCR4=(0|PORT_PCR_MUX(1));
-    PORTD_PCR5=(0|PORT_PCR_MUX(1));
-    PORTD_PCR6=(0|PORT_PCR_MUX(1));
+    HalGateSet(HAL_SCGC5, SIM_SCGC5_PORTD_MASK);    /* Enable clock gate for PORTD */
+    HalPinCfgSet(LCD_PORT, 1, PORT_PCR_MUX(1));
+    HalPinCfgSet(LCD_PORT, 2, PORT_PCR_MUX(1));
+    HalPinCfgSet(LCD_PORT, 3, PORT_PCR_MUX(1));
+    HalPinCfgSet(LCD_PORT, 4, PORT_PCR_MUX(1));
+    HalPinCfgSet(LCD_PORT, 5, PORT_PCR_MUX(1));
+    HalPinCfgSet(LCD_PORT, 6, PORT_PCR_MUX(1));
     INIT_BIT_DIR();
     LCD_CLR_E(); 
     LCD_SET_RS();           /*Data select unless in LcdWrCmd()  */
@@ -0,0 +1,237 @@
+/********************************************************************
+* Loopback.c - Digital DAC to ADC loopback with analog impairments
+* WaveTask copies each rendered DAC block into a FIFO. A capture
+* walks the FIFO at the ADC sample instants, the DAC rate over the
+* ADC rate, both the rationals the PITs really achieve, so the
+* position is exact and never drifts. Between samples the DAC holds
+* its output, so without a low-pass an ADC instant reads the DAC
+* sample in force. The optional RC low-pass is stepped once per DAC
+* sample and read between its end points.
+* After the analog path comes the ADC model: gain and offset error,
+* noise and quantization to the profile's resolution.
+*
+* agent, 10/18/2026
+********************************************************************/
+#include "MCUType.h"
+#include "app_cfg.h"
+#include "os.h"
+#include "Timebase.h"
+#include "Wave.h"
+#include "Loopback.h"
+
+#define LOOP_FIFO_SIZE 4096u            //DAC samples, a power of 2
+#define LOOP_DAC_TO_ADC 16.0f           //12 bit DAC code to 16 bit ADC counts, same reference
+#define LOOP_ADC_MAX 65535.0f
+#define LOOP_TWO_PI 6.28318531f
+#define LOOP_NOISE_SCALE (1.0f/37837.2f)    //rms of the sum of four 16 bit uniforms
+
+/*********************************************************************
+* Private Resources
+********************************************************************/
+static INT16U loopFifo[LOOP_FIFO_SIZE];
+static volatile INT32U loopWr = 0;      //Free running write index
+static volatile INT8U loopOn = FALSE;
+static LOOP_CFG loopCfg = {0, 0, 0, 0};
+static INT32U loopOverruns = 0;
+static INT32U loopSeed = 1u;
+static OS_SEM loopData;
+static INT8U loopRun = FALSE;           //FALSE makes the next capture start afresh
+static INT32U loopRd;                   //Capture state carried from one capture to the next
+static INT64U loopRem;
+static INT64U loopStepDen;
+static INT32U loopAdv;
+static FP32 loopY0;
+static FP32 loopY1;
+
+static FP32 loopNoise(void);
+
+/******************************************************************************
+ * LoopbackInit()
+ ******************************************************************************/
+void LoopbackInit(void){
+    OS_ERR os_err;
+
+    OSSemCreate(&loopData, "Loopback Data", 0, &os_err);
+    while(os_err != OS_ERR_NONE){}          //Error Trap
+}
+
+/******************************************************************************
+ * LoopbackEnable() - Wakes WaveTask in case the DMA is playing a loop table,
+ *  and a capture that is waiting for samples that will no longer come
+ ******************************************************************************/
+void LoopbackEnable(INT8U on){
+    OS_ERR os_err;
+
+    loopRun = FALSE;
+    loopOn = (on != FALSE) ? TRUE : FALSE;
+    WaveWake();
+    (void)OSSemPost(&loopData, OS_OPT_POST_1, &os_err);
+    while(os_err != OS_ERR_NONE){}          //Error Trap
+}
+
+/******************************************************************************
+ * LoopbackActive()
+ ******************************************************************************/
+INT8U LoopbackActive(void){
+    return loopOn;
+}
+
+/******************************************************************************
+ * LoopbackCfgSet()
+ ******************************************************************************/
+void LoopbackCfgSet(const LOOP_CFG *cfg){
+    loopCfg = *cfg;
+}
+
+/******************************************************************************
+ * LoopbackPush()
+ ******************************************************************************/
+void LoopbackPush(const INT16U *dac, INT16U n){
+    OS_ERR os_err;
+    INT32U wr = loopWr;
+    INT16U i;
+
+    if(loopOn != FALSE){
+        for(i = 0; i < n; i++){
+            loopFifo[(wr + i) & (LOOP_FIFO_SIZE - 1u)] = dac[i];
+        }
+        loopWr = wr + n;
+        (void)OSSemPost(&loopData, OS_OPT_POST_1, &os_err);
+        while(os_err != OS_ERR_NONE){}      //Error Trap
+    }else{}
+}
+
+/******************************************************************************
+ * LoopbackCapture() - The ADC instant sits 'rem/step_den' of a DAC period
+ *  after DAC sample rd-1 took over. y0 and y1 are the RC output at the
+ *  start and end of that period. All of it is kept for the next capture,
+ *  which starts afresh only after LoopbackEnable() or a new ADC rate.
+ ******************************************************************************/
+void LoopbackCapture(INT16U *adc, INT16U n, TB_RATE fs, INT8U bits){
+    OS_ERR os_err;
+    TB_RATE dac = TimebaseRateGet(TB_PIT_DAC);
+    LOOP_CFG cfg = loopCfg;
+    INT64U step_num = (INT64U)dac.num*fs.den;      //DAC samples per ADC sample = num/den
+    INT64U step_den = (INT64U)dac.den*fs.num;
+    INT32U step_whole = (INT32U)(step_num/step_den);
+    INT64U step_part = step_num%step_den;
+    INT64U rem;
+    INT32U adv;
+    INT32U rd;
+    FP32 alpha = 1.0f;
+    FP32 gain = LOOP_DAC_TO_ADC*(1.0f + ((FP32)cfg.gain_ppm*1.0e-6f));
+    FP32 lsb = (FP32)(1u << (16u - bits));
+    FP32 x;
+    FP32 y0;
+    FP32 y1;
+    INT8U start = FALSE;
+    FP32 v;
+    FP32 w;
+    INT16U i;
+
+    //Backward Euler RC, the pole stays inside the unit circle for any corner
+    if(cfg.lpf_hz != 0){
+        w = (LOOP_TWO_PI*cfg.lpf_hz*dac.den)/(FP32)dac.num;
+        alpha = w/(1.0f + w);
+    }else{}
+
+    if((loopRun == FALSE) || (step_den != loopStepDen)){
+        //Start from the next sample WaveTask renders, like the ADC starting now
+        (void)OSSemSet(&loopData, 0, &os_err);
+        while(os_err != OS_ERR_NONE){}      //Error Trap
+        rd = loopWr;
+        rem = 0;
+        adv = 1u;
+        y0 = 0.0f;
+        y1 = 0.0f;
+        start = TRUE;
+        loopStepDen = step_den;
+        loopRun = TRUE;
+    }else{
+        rd = loopRd;
+        rem = loopRem;
+        adv = loopAdv;
+        y0 = loopY0;
+        y1 = loopY1;
+    }
+    for(i = 0; i < n; i++){
+        //Hold and filter every DAC sample up to this ADC instant
+        while(adv > 0){
+            while((loopWr == rd) && (loopOn != FALSE)){
+                OSSemPend(&loopData, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+                while(os_err != OS_ERR_NONE){}  //Error Trap
+            }
+            if(loopWr == rd){
+                //Switched off, the DAC holds its last sample for the rest of the capture
+                x = (FP32)loopFifo[(rd - 1u) & (LOOP_FIFO_SIZE - 1u)];
+            }else{
+                if((loopWr - rd) > LOOP_FIFO_SIZE){
+                    loopOverruns++;
+                    rd = loopWr - 1u;
+                }else{}
+                x = (FP32)loopFifo[rd & (LOOP_FIFO_SIZE - 1u)];
+                rd++;
+            }
+            y0 = y1;
+            if(start != FALSE){
+                y0 = x;             //Start settled
+                start = FALSE;
+            }else{}
+            y1 = y0 + ((x - y0)*alpha);
+            adv--;
+        }
+        if(cfg.lpf_hz != 0){
+            v = y0 + ((y1 - y0)*((FP32)rem/(FP32)step_den));
+        }else{
+            v = y1;
+        }
+
+        //ADC front end
+        v = (v*gain) + (FP32)cfg.offset;
+        if(cfg.noise_rms != 0){
+            v = v + ((FP32)cfg.noise_rms*loopNoise());
+        }else{}
+        v = (v/lsb) + 0.5f;
+        if(v < 0.0f){
+            v = 0.0f;
+        }else if(v > (LOOP_ADC_MAX/lsb)){
+            v = LOOP_ADC_MAX/lsb;
+        }else{}
+        adc[i] = (INT16U)v;
+
+        //Next ADC instant
+        rem = rem + step_part;
+        adv = step_whole;
+        if(rem >= step_den){
+            rem = rem - step_den;
+            adv++;
+        }else{}
+    }
+    loopRd = rd;
+    loopRem = rem;
+    loopAdv = adv;
+    loopY0 = y0;
+    loopY1 = y1;
+}
+
+/******************************************************************************
+ * LoopbackOverruns()
+ ******************************************************************************/
+INT32U LoopbackOverruns(void){
+    return loopOverruns;
+}
+
+/******************************************************************************
+ * loopNoise() - Unit rms noise, close to Gaussian, from the sum of four
+ *  uniforms. The top 16 bits of an LCG are used, the low bits are poor.
+ ******************************************************************************/
+static FP32 loopNoise(void){
+    INT32U sum = 0;
+    INT8U k;
+
+    for(k = 0; k < 4u; k++){
+        loopSeed = (loopSeed*1664525u) + 1013904223u;
+        sum = sum + (loopSeed >> 16);
+    }
+    return ((FP32)sum - 131070.0f)*LOOP_NOISE_SCALE;
+}
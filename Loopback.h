@@ -0,0 +1,65 @@
+/********************************************************************
+* Loopback.h - Header file for the digital DAC to ADC loopback
+* Feeds the analyzer the samples WaveTask renders for the DAC, as
+* the ADC would have seen them through an imperfect analog path,
+* so the analyzer can be checked without a wire between DAC0 and
+* ADC0.
+* Timebase.h has to be included before this header.
+*
+* agent, 10/18/2026
+********************************************************************/
+#ifndef LOOPBACK_H_
+#define LOOPBACK_H_
+
+//Analog path impairments. Counts are 16 bit ADC counts.
+typedef struct{
+    INT32S gain_ppm;        //Gain error, 0 = nominal DAC to ADC scale
+    INT32S offset;          //Offset error in counts
+    INT16U noise_rms;       //White noise in counts rms
+    INT16U lpf_hz;          //Corner of a one pole RC low-pass, 0 = none
+} LOOP_CFG;
+
+/******************************************************************************
+ * LoopbackInit() - Creates the data semaphore. Loopback starts off with an
+ *  ideal path.
+ ******************************************************************************/
+void LoopbackInit(void);
+
+/******************************************************************************
+ * LoopbackEnable() - TRUE routes the DAC stream to the analyzer instead of
+ *  ADC0. WaveTask streams blocks while the loopback is on, it does not hand
+ *  playback over to a DMA loop table.
+ ******************************************************************************/
+void LoopbackEnable(INT8U on);
+
+/******************************************************************************
+ * LoopbackActive() - TRUE while the loopback is on
+ ******************************************************************************/
+INT8U LoopbackActive(void);
+
+/******************************************************************************
+ * LoopbackCfgSet() - Sets the analog path. Takes effect at the next capture.
+ ******************************************************************************/
+void LoopbackCfgSet(const LOOP_CFG *cfg);
+
+/******************************************************************************
+ * LoopbackPush() - Called by WaveTask with every block it renders for the
+ *  DAC. Does nothing while the loopback is off.
+ ******************************************************************************/
+void LoopbackPush(const INT16U *dac, INT16U n);
+
+/******************************************************************************
+ * LoopbackCapture() - Fills adc[0..n-1] with what ADC0 would have converted
+ *  at rate 'fs' with 'bits' of resolution. Each capture carries on where
+ *  the last one stopped, the first after LoopbackEnable() or a change of
+ *  'fs' starts from the next DAC sample. Pends on WaveTask for the samples,
+ *  so it runs in real time.
+ ******************************************************************************/
+void LoopbackCapture(INT16U *adc, INT16U n, TB_RATE fs, INT8U bits);
+
+/******************************************************************************
+ * LoopbackOverruns() - Number of times the capture fell a whole FIFO behind
+ ******************************************************************************/
+INT32U LoopbackOverruns(void);
+
+#endif
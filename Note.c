@@ -0,0 +1,73 @@
+/********************************************************************
+* Note.c - Frequency to note mapping
+* Replaces the if/else ladder of thresholds in ADCTask with a table
+* of note centers and boundaries in octave 0. The frequency is
+* shifted down to octave 0 in Q16 so the table search and the cents
+* calculation keep 16 fraction bits.
+*
+* agent, 10/18/2026
+********************************************************************/
+#include "MCUType.h"
+#include "Note.h"
+
+#define NOTE_Q 16               //Fraction bits of octave 0 frequencies
+#define NOTES_PER_OCT 12u
+#define NOTE_CENTS_K 3462       //2400/ln(2), see NoteFromFreq()
+#define NOTE_CENTS_MAX 50
+
+//Octave 0 in Q16 Hz. C0 = 440*2^(-57/12) = 16.352Hz
+typedef struct{
+    INT8C *name;
+    INT32U center;      //C0*2^(i/12)
+    INT32U upper;       //C0*2^((i + 0.5)/12), halfway to the next note in cents
+} NOTE_BAND;
+
+static const NOTE_BAND noteBands[NOTES_PER_OCT] = {
+    {"C",  1071618u, 1103019u},     //16.352Hz  <16.831Hz
+    {"C#", 1135340u, 1168608u},     //17.324Hz  <17.832Hz
+    {"D",  1202851u, 1238097u},     //18.354Hz  <18.892Hz
+    {"D#", 1274376u, 1311718u},     //19.445Hz  <20.015Hz
+    {"E",  1350154u, 1389717u},     //20.602Hz  <21.205Hz
+    {"F",  1430439u, 1472354u},     //21.827Hz  <22.466Hz
+    {"F#", 1515497u, 1559905u},     //23.125Hz  <23.802Hz
+    {"G",  1605613u, 1652661u},     //24.500Hz  <25.218Hz
+    {"G#", 1701088u, 1750934u},     //25.957Hz  <26.717Hz
+    {"A",  1802240u, 1855050u},     //27.500Hz  <28.306Hz
+    {"A#", 1909407u, 1965357u},     //29.135Hz  <29.989Hz
+    {"B",  2022946u, 2082223u},     //30.868Hz  <31.772Hz, top of octave 0
+};
+
+/******************************************************************************
+ * NoteFromFreq() - Finds the octave by halving the frequency until it is
+ *  inside octave 0, then the first band whose upper bound is above it.
+ *  Cents use 1200*log2(f/c) ~= (2400/ln2)*(f - c)/(f + c), which is within
+ *  0.01 cent over +-50 cents.
+ ******************************************************************************/
+void NoteFromFreq(NOTE *note){
+    INT64U f_q = (INT64U)note->freq << NOTE_Q;
+    INT32U f0;
+    INT8U oct = 0;
+    INT8U i = 0;
+    INT32S cents;
+
+    while((f_q >> oct) >= noteBands[NOTES_PER_OCT - 1u].upper){
+        oct++;
+    }
+    f0 = (INT32U)(f_q >> oct);
+
+    while(f0 >= noteBands[i].upper){
+        i++;
+    }
+    //64 bit product, f0 is far below the center for inputs under C0
+    cents = (INT32S)(((INT64S)NOTE_CENTS_K*((INT32S)f0 - (INT32S)noteBands[i].center))
+            /((INT32S)f0 + (INT32S)noteBands[i].center));
+    if(cents < -NOTE_CENTS_MAX){
+        cents = -NOTE_CENTS_MAX;        //Below C0
+    } else if(cents > NOTE_CENTS_MAX){
+        cents = NOTE_CENTS_MAX;
+    } else{}
+
+    note->note = noteBands[i].name;
+    note->oct = oct;
+    note->cents = (INT8S)cents;
+}
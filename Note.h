@@ -0,0 +1,25 @@
+/********************************************************************
+* Note.h - Header file for the frequency to note mapping module
+* Maps a frequency in Hz onto equal tempered note, octave and cents
+* (A4 = 440Hz). Has no hardware or RTOS dependencies.
+*
+* agent, 10/18/2026
+********************************************************************/
+#ifndef NOTE_H_
+#define NOTE_H_
+
+//Note structure
+typedef struct{
+    INT8C *note;
+    INT8U oct;
+    INT8S cents;        //Offset from the nearest note, -50 to +50
+    INT32U freq;
+} NOTE;
+
+/******************************************************************************
+ * NoteFromFreq() - Fills in note, oct and cents of 'note' from note->freq.
+ *  Frequencies below C0 map to C0 with cents held at -50.
+ ******************************************************************************/
+void NoteFromFreq(NOTE *note);
+
+#endif
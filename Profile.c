@@ -0,0 +1,181 @@
+/********************************************************************
+* Profile.c - On-target timing profiler
+* Release, start and finish are DWT->CYCCNT stamps. The counter
+* wraps every 2^32 core cycles, about 24s at 180MHz, which only
+* matters for single jobs, so every job span is an unsigned
+* difference. The window length comes from the OS tick instead so
+* the occupancy figures are right over windows of any length.
+* Releases queue up per job, so a job that overruns its period is
+* still measured from its own release, not from the next one.
+*
+* agent, 10/18/2026
+********************************************************************/
+#include "MCUType.h"
+#include "app_cfg.h"
+#include "os.h"
+#include "Hal.h"
+#include "Timebase.h"
+#include "Profile.h"
+
+#define PROF_CYCLES_PER_US (TB_CORE_CLOCK/1000000u)
+#define PROF_REL_DEPTH 4u               //Releases queued per job, a power of 2
+
+typedef struct{
+    INT32U rel_queue[PROF_REL_DEPTH];   //CYCCNT at each release not yet finished
+    volatile INT32U rel_wr;             //Free running, ProfileRelease() only
+    volatile INT32U rel_rd;             //Free running, the job's owner only
+    volatile INT32U rel_lost;           //Releases dropped on a full queue, ProfileRelease() only
+    INT32U release;         //CYCCNT stamps of the job in progress
+    INT32U begin;
+    INT8U released;         //The job in progress came from the queue
+    INT32U deadline;        //Cycles, PROF_NO_DEADLINE for none
+    INT32U jobs;
+    INT32U misses;
+    INT32U resp_max;
+    INT32U exec_max;
+    INT64U resp_sum;
+    INT64U busy;            //Start to finish cycles summed over the window,
+                            //preemption included
+} PROF_JOB;
+
+/*********************************************************************
+* Private Resources
+********************************************************************/
+static PROF_JOB profJobs[PROF_NUM];
+static OS_TICK profWindowTick;          //OS tick the window opened at
+
+/******************************************************************************
+ * ProfileInit()
+ ******************************************************************************/
+void ProfileInit(void){
+    INT8U id;
+
+    HalCycleCountStart();
+    for(id = 0; id < PROF_NUM; id++){
+        profJobs[id].deadline = PROF_NO_DEADLINE;
+    }
+    ProfileReset();
+}
+
+/******************************************************************************
+ * ProfileReset()
+ ******************************************************************************/
+void ProfileReset(void){
+    OS_ERR os_err;
+    INT8U id;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    for(id = 0; id < PROF_NUM; id++){
+        profJobs[id].jobs = 0;
+        profJobs[id].misses = 0;
+        profJobs[id].resp_max = 0;
+        profJobs[id].exec_max = 0;
+        profJobs[id].resp_sum = 0;
+        profJobs[id].busy = 0;
+        profJobs[id].rel_lost = 0;
+    }
+    CPU_CRITICAL_EXIT();
+    profWindowTick = OSTimeGet(&os_err);
+}
+
+/******************************************************************************
+ * ProfileDeadlineSet()
+ ******************************************************************************/
+void ProfileDeadlineSet(PROF_ID id, INT32U cycles){
+    profJobs[id].deadline = cycles;
+}
+
+/******************************************************************************
+ * ProfileRelease() - Queues the release stamp. A job PROF_REL_DEPTH releases
+ *  behind has missed its deadline whatever happens next, so a release that
+ *  finds the queue full is dropped and counted as a miss.
+ ******************************************************************************/
+void ProfileRelease(PROF_ID id){
+    PROF_JOB *job = &profJobs[id];
+    INT32U wr = job->rel_wr;
+
+    if((wr - job->rel_rd) >= PROF_REL_DEPTH){
+        job->rel_lost++;
+    }else{
+        job->rel_queue[wr & (PROF_REL_DEPTH - 1u)] = HalCycleCount();
+        job->rel_wr = wr + 1u;
+    }
+}
+
+/******************************************************************************
+ * ProfileReleaseFlush() - Only the owner calls it, so rel_rd stays owned by
+ *  one side.
+ ******************************************************************************/
+void ProfileReleaseFlush(PROF_ID id){
+    profJobs[id].rel_rd = profJobs[id].rel_wr;
+}
+
+/******************************************************************************
+ * ProfileBegin() - Takes the oldest queued release
+ ******************************************************************************/
+void ProfileBegin(PROF_ID id){
+    PROF_JOB *job = &profJobs[id];
+    INT32U rd = job->rel_rd;
+
+    job->begin = HalCycleCount();
+    if(rd != job->rel_wr){
+        job->release = job->rel_queue[rd & (PROF_REL_DEPTH - 1u)];
+        job->released = TRUE;
+    }else{
+        job->release = job->begin;
+        job->released = FALSE;
+    }
+}
+
+/******************************************************************************
+ * ProfileEnd() - Only the owner of a job calls ProfileEnd(), so the figures
+ *  need no lock. ProfileGet() and ProfileReset() take one to read or clear
+ *  them all at once.
+ ******************************************************************************/
+void ProfileEnd(PROF_ID id){
+    PROF_JOB *job = &profJobs[id];
+    INT32U end = HalCycleCount();
+    INT32U exec = end - job->begin;
+    INT32U resp = end - job->release;
+
+    if(job->released != FALSE){
+        job->rel_rd = job->rel_rd + 1u;     //Frees the slot only once the job is done
+    }else{}
+    job->released = FALSE;
+    job->jobs++;
+    job->busy = job->busy + exec;
+    job->resp_sum = job->resp_sum + resp;
+    if(exec > job->exec_max){
+        job->exec_max = exec;
+    }else{}
+    if(resp > job->resp_max){
+        job->resp_max = resp;
+    }else{}
+    if((job->deadline != PROF_NO_DEADLINE) && (resp > job->deadline)){
+        job->misses++;
+    }else{}
+}
+
+/******************************************************************************
+ * ProfileGet()
+ ******************************************************************************/
+void ProfileGet(PROF_ID id, PROF_STATS *stats){
+    OS_ERR os_err;
+    PROF_JOB job;
+    INT64U window;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    job = profJobs[id];
+    CPU_CRITICAL_EXIT();
+    window = ((INT64U)(OSTimeGet(&os_err) - profWindowTick)*TB_CORE_CLOCK)/OS_CFG_TICK_RATE_HZ;
+
+    stats->jobs = job.jobs;
+    stats->misses = job.misses + job.rel_lost;
+    stats->resp_max_us = job.resp_max/PROF_CYCLES_PER_US;
+    stats->resp_mean_us = (job.jobs != 0) ? (INT32U)((job.resp_sum/job.jobs)/PROF_CYCLES_PER_US) : 0u;
+    stats->exec_max_us = job.exec_max/PROF_CYCLES_PER_US;
+    stats->deadline_us = job.deadline/PROF_CYCLES_PER_US;
+    stats->occ_x100 = (window != 0) ? (INT32U)((job.busy*10000u)/window) : 0u;
+}
@@ -0,0 +1,82 @@
+/********************************************************************
+* Profile.h - Header file for the on-target timing profiler
+* Times the real-time jobs with the DWT cycle counter: when each job
+* was released, when it started and when it finished. From that it
+* keeps response times, deadline misses and how much of a
+* measurement window every job was in progress.
+* Start to finish spans are wall time: a job that is preempted keeps
+* counting while the higher priority work runs. Execution and
+* occupancy figures are upper bounds on the CPU the job itself used.
+*
+* agent, 10/18/2026
+********************************************************************/
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+//Profiled jobs
+typedef enum{
+    PROF_DMA_ISR,       //DAC ring interrupt
+    PROF_WAVE,          //One ring block rendered by WaveTask
+    PROF_ADC,           //One capture hop analyzed by ADCTask
+    PROF_NUM
+} PROF_ID;
+
+#define PROF_NO_DEADLINE 0u
+
+//Figures for one job since the last ProfileReset(), times in us
+typedef struct{
+    INT32U jobs;
+    INT32U misses;          //Jobs that finished after their deadline, or whose
+                            //release found the queue full
+    INT32U resp_max_us;     //Release to finish
+    INT32U resp_mean_us;
+    INT32U exec_max_us;     //Start to finish, preemption included
+    INT32U deadline_us;
+    INT32U occ_x100;        //Start to finish time over the window in 1/100 %
+} PROF_STATS;
+
+/******************************************************************************
+ * ProfileInit() - Starts the DWT cycle counter and opens the first window
+ ******************************************************************************/
+void ProfileInit(void);
+
+/******************************************************************************
+ * ProfileReset() - Clears every job's figures and opens a new window
+ ******************************************************************************/
+void ProfileReset(void);
+
+/******************************************************************************
+ * ProfileDeadlineSet() - Relative deadline of job 'id' in core cycles.
+ *  PROF_NO_DEADLINE turns miss counting off.
+ ******************************************************************************/
+void ProfileDeadlineSet(PROF_ID id, INT32U cycles);
+
+/******************************************************************************
+ * ProfileRelease() - The work of job 'id' became ready, e.g. an ISR posted.
+ *  Up to 4 releases queue up, one for each job not yet finished.
+ ******************************************************************************/
+void ProfileRelease(PROF_ID id);
+
+/******************************************************************************
+ * ProfileReleaseFlush() - Drops the queued releases of job 'id', for when its
+ *  owner throws away the work they stood for
+ ******************************************************************************/
+void ProfileReleaseFlush(PROF_ID id);
+
+/******************************************************************************
+ * ProfileBegin() - Job 'id' starts running, measured from its oldest queued
+ *  release. A job with no release queued is released here.
+ ******************************************************************************/
+void ProfileBegin(PROF_ID id);
+
+/******************************************************************************
+ * ProfileEnd() - Job 'id' is done. Updates its figures.
+ ******************************************************************************/
+void ProfileEnd(PROF_ID id);
+
+/******************************************************************************
+ * ProfileGet() - Copies the figures of job 'id' to *stats
+ ******************************************************************************/
+void ProfileGet(PROF_ID id, PROF_STATS *stats);
+
+#endif
@@ -0,0 +1,203 @@
+/********************************************************************
+* Sweep.c - Log sweep characterization of the frequency analyzer
+* ADCTask drives the sweep from its frame loop: each estimate is
+* checked against the generator frequency and, once it has been in
+* tolerance for SWEEP_SETTLE_FRAMES frames, the generator is set to
+* the next step with FreqSet(). A target under 1.5 bins cannot be
+* told apart from DC or its neighbours, and its one bin tolerance
+* would pass on bin 1 alone, so such a step is marked unresolvable
+* after one frame and skipped. The results stay in RAM for the
+* debugger or the LCD.
+*
+* agent, 10/18/2026
+********************************************************************/
+#include "MCUType.h"
+#include "app_cfg.h"
+#include "os.h"
+#include "Wave.h"
+#include "Sweep.h"
+
+#define SWEEP_START_HZ 10.0f
+#define SWEEP_RATIO 1.258925412f        //10^(1/10), one step
+#define SWEEP_SETTLE_FRAMES 2u          //Frames in tolerance before a step counts as settled
+#define SWEEP_MAX_FRAMES 12u            //Frames before a step times out
+#define SWEEP_TOL_PCT 1u                //Tolerance, 1% of the target or one bin if wider
+
+typedef enum{SWEEP_IDLE, SWEEP_REQ, SWEEP_RUN} SWEEP_STATE;
+
+/*********************************************************************
+* Private Resources
+********************************************************************/
+static SWEEP_POINT sweepTable[SWEEP_STEPS];
+static SWEEP_RESULT sweepResult;
+static volatile INT8U sweepState = SWEEP_IDLE;
+static INT16U sweepRestore;             //Frequency to go back to
+static INT8U sweepStep;
+static INT8U sweepHits;                 //Frames in a row within tolerance
+static OS_TICK sweepStepTick;           //FreqSet() time of the current step
+static OS_TICK sweepStartTick;
+
+static void sweepStepSet(INT8U step, OS_TICK now);
+static void sweepFinish(OS_TICK now);
+
+/******************************************************************************
+ * SweepStart()
+ ******************************************************************************/
+void SweepStart(INT16U restore_freq){
+    if(sweepState == SWEEP_IDLE){
+        sweepRestore = restore_freq;
+        sweepState = SWEEP_REQ;
+    }else{}
+}
+
+/******************************************************************************
+ * SweepFrame() - The frame that was being captured when the step changed
+ *  is counted too, so settle_ms is the full latency seen by a user.
+ ******************************************************************************/
+void SweepFrame(INT32U est_hz, INT32U bin_hz){
+    OS_ERR os_err;
+    OS_TICK now = OSTimeGet(&os_err);
+    SWEEP_POINT *pt;
+    INT32U tol;
+    INT32U err;
+    INT8U step;
+    FP32 freq;
+
+    if(sweepState == SWEEP_REQ){
+        freq = SWEEP_START_HZ;
+        for(step = 0; step < SWEEP_STEPS; step++){
+            sweepTable[step].target = (INT16U)(freq + 0.5f);
+            sweepTable[step].est = 0;
+            sweepTable[step].settle_ms = 0;
+            sweepTable[step].frames = 0;
+            sweepTable[step].settled = FALSE;
+            sweepTable[step].resolvable = TRUE;
+            freq = freq*SWEEP_RATIO;
+        }
+        sweepStartTick = now;
+        sweepState = SWEEP_RUN;
+        sweepStepSet(0, now);
+    }else if(sweepState == SWEEP_RUN){
+        pt = &sweepTable[sweepStep];
+        pt->est = (INT16U)est_hz;
+        pt->frames++;
+        if(((INT32U)pt->target*2u) < (bin_hz*SWEEP_MIN_BINS_X2)){
+            pt->resolvable = FALSE;
+        }else{}
+        tol = (pt->target*SWEEP_TOL_PCT)/100u;
+        if(tol < bin_hz){
+            tol = bin_hz;
+        }else{}
+        err = (est_hz > pt->target) ? (est_hz - pt->target) : (pt->target - est_hz);
+        if(err <= tol){
+            if(sweepHits == 0){
+                pt->settle_ms = (INT16U)(((now - sweepStepTick)*1000u)/OS_CFG_TICK_RATE_HZ);
+            }else{}
+            sweepHits++;
+        }else{
+            sweepHits = 0;
+        }
+        if(sweepHits >= SWEEP_SETTLE_FRAMES){
+            pt->settled = TRUE;
+        }else if(pt->frames >= SWEEP_MAX_FRAMES){
+            pt->settle_ms = (INT16U)(((now - sweepStepTick)*1000u)/OS_CFG_TICK_RATE_HZ);
+        }else{}
+        if((pt->settled != FALSE) || (pt->frames >= SWEEP_MAX_FRAMES) || (pt->resolvable == FALSE)){
+            if(sweepStep < (SWEEP_STEPS - 1u)){
+                sweepStepSet(sweepStep + 1u, now);
+            }else{
+                sweepFinish(now);
+            }
+        }else{}
+    }else{}
+}
+
+/******************************************************************************
+ * SweepRunning()
+ ******************************************************************************/
+INT8U SweepRunning(void){
+    return (sweepState != SWEEP_IDLE) ? TRUE : FALSE;
+}
+
+/******************************************************************************
+ * SweepResultGet()
+ ******************************************************************************/
+void SweepResultGet(SWEEP_RESULT *result){
+    *result = sweepResult;
+}
+
+/******************************************************************************
+ * SweepTableGet()
+ ******************************************************************************/
+const SWEEP_POINT *SweepTableGet(void){
+    return &sweepTable[0];
+}
+
+/******************************************************************************
+ * sweepStepSet() - Sets the generator to step 'step'
+ ******************************************************************************/
+static void sweepStepSet(INT8U step, OS_TICK now){
+    INT16U freq = sweepTable[step].target;
+
+    sweepStep = step;
+    sweepHits = 0;
+    sweepStepTick = now;
+    FreqSet(&freq);
+}
+
+/******************************************************************************
+ * sweepFinish() - Works out the run figures and restores the generator.
+ *  Errors are relative so every decade counts the same. Unresolvable steps
+ *  are only counted.
+ ******************************************************************************/
+static void sweepFinish(OS_TICK now){
+    SWEEP_POINT *pt;
+    INT32S err_x100;
+    INT32U abs_x100;
+    INT32U err_sum = 0;
+    INT32U settle_sum = 0;
+    INT64U est_x_target = 0;
+    INT64U target_sq = 0;
+    INT8U step;
+    INT8U settled = 0;
+    INT8U resolved = 0;
+
+    sweepResult.worst_err_x100 = 0;
+    sweepResult.worst_settle_ms = 0;
+    sweepResult.unsettled = 0;
+    sweepResult.unresolved = 0;
+    for(step = 0; step < SWEEP_STEPS; step++){
+        pt = &sweepTable[step];
+        if(pt->resolvable == FALSE){
+            sweepResult.unresolved++;
+        }else{
+            resolved++;
+            err_x100 = (((INT32S)pt->est - (INT32S)pt->target)*10000)/(INT32S)pt->target;
+            abs_x100 = (err_x100 < 0) ? (INT32U)(-err_x100) : (INT32U)err_x100;
+            if(abs_x100 > ((sweepResult.worst_err_x100 < 0) ? (INT32U)(-sweepResult.worst_err_x100) : (INT32U)sweepResult.worst_err_x100)){
+                sweepResult.worst_err_x100 = err_x100;
+            }else{}
+            err_sum = err_sum + abs_x100;
+            if(pt->settled != FALSE){
+                settled++;
+                settle_sum = settle_sum + pt->settle_ms;
+                if(pt->settle_ms > sweepResult.worst_settle_ms){
+                    sweepResult.worst_settle_ms = pt->settle_ms;
+                }else{}
+                est_x_target = est_x_target + ((INT64U)pt->est*pt->target);
+                target_sq = target_sq + ((INT64U)pt->target*pt->target);
+            }else{
+                sweepResult.unsettled++;
+            }
+        }
+    }
+    sweepResult.mean_err_x100 = (resolved != 0) ? (err_sum/resolved) : 0u;
+    sweepResult.mean_settle_ms = (settled != 0) ? (INT16U)(settle_sum/settled) : 0u;
+    sweepResult.gain_ppm = (target_sq != 0) ? (INT32U)((est_x_target*1000000u)/target_sq) : 0u;
+    sweepResult.run_ms = ((now - sweepStartTick)*1000u)/OS_CFG_TICK_RATE_HZ;
+    sweepResult.steps_per_s_x100 = (sweepResult.run_ms != 0) ?
+        ((SWEEP_STEPS*100000u)/sweepResult.run_ms) : 0u;
+
+    FreqSet(&sweepRestore);
+    sweepState = SWEEP_IDLE;
+}
@@ -0,0 +1,66 @@
+/********************************************************************
+* Sweep.h - Header file for the generator/analyzer sweep module
+* Steps the generator through a log sweep and records what the
+* analyzer measures at every step, so the analyzer can be
+* characterized without reading the LCD by eye.
+*
+* agent, 10/18/2026
+********************************************************************/
+#ifndef SWEEP_H_
+#define SWEEP_H_
+
+#define SWEEP_STEPS 31u             //10Hz to 10kHz, 10 steps per decade
+#define SWEEP_MIN_BINS_X2 3u        //Lowest resolvable target, 1.5 bins, times 2
+
+//One step of the sweep
+typedef struct{
+    INT16U target;          //Generator frequency in Hz
+    INT16U est;             //Last analyzer frame estimate in Hz
+    INT16U settle_ms;       //Time from FreqSet() to the first in-tolerance frame
+    INT8U frames;           //Frames spent on the step
+    INT8U settled;          //FALSE if the step timed out
+    INT8U resolvable;       //FALSE if the target is under SWEEP_MIN_BINS bins
+} SWEEP_POINT;
+
+//Figures for a whole run, worked out when the last step is done. Steps
+//the analyzer cannot resolve are left out of every error and settle figure.
+typedef struct{
+    INT32S worst_err_x100;  //Worst estimate error in 1/100 % of the target, signed
+    INT32U mean_err_x100;   //Mean absolute estimate error in 1/100 %
+    INT32U gain_ppm;        //Least squares est/target over settled steps, 1000000 = exact
+    INT16U worst_settle_ms;
+    INT16U mean_settle_ms;
+    INT8U unsettled;        //Resolvable steps that timed out
+    INT8U unresolved;       //Steps under SWEEP_MIN_BINS bins
+    INT32U run_ms;          //Whole sweep
+    INT32U steps_per_s_x100;    //Throughput
+} SWEEP_RESULT;
+
+/******************************************************************************
+ * SweepStart() - Asks for a sweep. It starts with the analyzer's next frame.
+ *  The generator goes back to 'restore_freq' when the sweep is done.
+ ******************************************************************************/
+void SweepStart(INT16U restore_freq);
+
+/******************************************************************************
+ * SweepFrame() - Called by ADCTask with every frame's estimate and the bin
+ *  width. Records the step and moves the generator on once it settles.
+ ******************************************************************************/
+void SweepFrame(INT32U est_hz, INT32U bin_hz);
+
+/******************************************************************************
+ * SweepRunning() - TRUE while a sweep is asked for or in progress
+ ******************************************************************************/
+INT8U SweepRunning(void);
+
+/******************************************************************************
+ * SweepResultGet() - Copies the figures of the last finished sweep to *result
+ ******************************************************************************/
+void SweepResultGet(SWEEP_RESULT *result);
+
+/******************************************************************************
+ * SweepTableGet() - The SWEEP_STEPS point table of the last sweep
+ ******************************************************************************/
+const SWEEP_POINT *SweepTableGet(void);
+
+#endif
@@ -16,19 +16,37 @@
 #include "MCUType.h"
 #include "app_cfg.h"
 #include "os.h"
+#include "Hal.h"
 #include "K65TWR_GPIO.h"
 #include "LcdLayered.h"
 #include "uCOSKey.h"
 #include "Time.h"
 #include "Tsi.h"
 #include "Wave.h"
+#include "Note.h"
 #include "ADC.h"
+#include "Sweep.h"
+#include "Profile.h"
+#include "Timebase.h"
+#include "Loopback.h"
+#include "DspArena.h"
+#include "Window.h"
 
 #define A 0x11
 #define B 0x12
 #define C 0x13
 
 #define NOTE_REFRESH_PER 500    //Period in ms that LCD updates note display
+#define APP_ADC_PROFILE ADC_PROF_16BIT_AVG4     //Capture profile at start up, see ADC.h
+#define APP_ADC_WINDOW WIN_HANN                 //Analyzer window at start up, see Window.h
+
+//Analog path the loopback models when it is switched on, # on an empty entry
+static const LOOP_CFG loopDefault = {
+    2000,       //Gain error, +0.2%
+    -40,        //Offset error in counts
+    12u,        //Noise, counts rms
+    20000u      //DAC reconstruction filter corner in Hz
+};
 
 typedef enum {RESET, TIME_SET, TIME} STATE;
 
@@ -102,13 +120,21 @@ static void AppStartTask(void *p_arg){
     (void)p_arg;        //void compiler warning for unused variable
 
     OS_CPU_SysTickInitFreq(DEFAULT_SYSTEM_CLOCK);
+    ProfileInit();
 
     GpioDBugBitsInit();
     LcdInit();
     KeyInit();
     TsiInit();
+    LoopbackInit();
+    LoopbackCfgSet(&loopDefault);
     WaveInit();
     ADCInit();
+    //A profile that overruns its sample period is refused, fall back to the default
+    if(ADCProfileSet(APP_ADC_PROFILE) == FALSE){
+        while(ADCProfileSet(ADC_PROF_DEFAULT) == FALSE){}    //Error Trap
+    }else{}
+    ADCWindowSet(APP_ADC_WINDOW);
 
     OSTaskCreate(&UITaskTCB,                //Create UITask
                 "UITask ",
@@ -166,6 +192,9 @@ static void AppStartTask(void *p_arg){
 * D to delete previous number
 * A to switch waveform to sine wave
 * B to switch waveform to triangle wave
+* C to step waveform through sawtooth, square, wavetable and additive
+* * to run a log sweep of the analyzer (see Sweep.c)
+* # with nothing entered to switch the DAC to ADC loopback on or off (see Loopback.c)
 *****************************************************************************************/
 static void UITask(void *p_arg){
     OS_ERR os_err;
@@ -174,7 +203,7 @@ static void UITask(void *p_arg){
     INT8C keyPress;
     INT8U keyValue;
     INT8U notDone;
-    INT8U waveform = 1;
+    INT8U waveform = SINE;
     INT16U newFreq;
 
     TypeSet(&waveform);
@@ -191,19 +220,36 @@ static void UITask(void *p_arg){
 			case '#': if(newFreq >=10){
 							notDone = 0;
 						}
+						else if(newFreq == 0){
+							LoopbackEnable((LoopbackActive() == FALSE) ? TRUE : FALSE);
+						}
 						else{
 						}
 						break;
 			//if a D is entered, moves back one space
 			case 0x14: newFreq = newFreq/10;
 					  break;
-			//A and B set the waveform type
-			case 0x11: waveform = 1;
+			//A, B and C set the waveform type
+			case 0x11: waveform = SINE;
 				TypeSet(&waveform);
 				break;
-			case 0x12: waveform = 2;
+			case 0x12: waveform = TRIANGLE;
 				TypeSet(&waveform);
 				break;
+			case 0x13: if(waveform == SAWTOOTH){
+					waveform = SQUARE;
+				}else if(waveform == SQUARE){
+					waveform = WAVETABLE;
+				}else if(waveform == WAVETABLE){
+					waveform = ADDITIVE;
+				}else{
+					waveform = SAWTOOTH;
+				}
+				TypeSet(&waveform);
+				break;
+			//* runs a log sweep of the analyzer, then goes back to Freq
+			case '*': SweepStart(Freq);
+				break;
 			//any number updates the new frequency
 			case '1':
 			case '2':
@@ -340,6 +386,21 @@ static void NoteDispTask(void *p_arg){
         LcdDispByte(1, 12, NOTE_DISP_LAYER, note.oct);
         LcdDispString(1, 9, NOTE_DISP_LAYER, "Oct:");
 
+        //L while the analyzer listens to the loopback instead of ADC0
+        if(LoopbackActive() != FALSE){
+            LcdDispChar(1, 14, NOTE_DISP_LAYER, 'L');
+        } else{}
+
+        //Cents from the nearest note, cols 6-8 clear of the keypad entry in cols 1-5.
+        //|cents| <= 50 so the hundreds digit at col 6 is never drawn over the sign.
+        if(note.cents < 0){
+            LcdDispChar(2, 6, NOTE_DISP_LAYER, '-');
+            LcdDispDecByte(2, 6, NOTE_DISP_LAYER, (INT8U)(-note.cents), 0);
+        } else{
+            LcdDispChar(2, 6, NOTE_DISP_LAYER, '+');
+            LcdDispDecByte(2, 6, NOTE_DISP_LAYER, (INT8U)note.cents, 0);
+        }
+
         //Frequency
         freq_low =(INT8U)(note.freq-((note.freq/100)*100));
         freq_mid = (INT8U)((note.freq-((note.freq/10000)*10000))/100);
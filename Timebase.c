@@ -0,0 +1,63 @@
+/********************************************************************
+* Timebase.c - Single owner of the bus clock and PIT reload values
+* The PIT period is LDVAL + 1 bus cycles, so a channel started at
+* 'rate' Hz really runs at TB_BUS_CLOCK/(LDVAL + 1). That exact rate
+* is kept as a rational so the analyzer's bin math and the wave
+* generator's phase increments can use it without rounding.
+*
+* agent, 10/18/2026
+********************************************************************/
+#include "MCUType.h"
+#include "Hal.h"
+#include "Timebase.h"
+
+/*********************************************************************
+* Private Resources
+********************************************************************/
+static TB_RATE tbRates[TB_PIT_NUM];
+
+/******************************************************************************
+ * TimebasePitLoad() - Rounds TB_BUS_CLOCK/rate_hz to the nearest period and
+ *  returns the matching reload value
+ ******************************************************************************/
+INT32U TimebasePitLoad(INT32U rate_hz){
+    return ((TB_BUS_CLOCK + (rate_hz/2u))/rate_hz) - 1u;
+}
+
+/******************************************************************************
+ * TimebasePitStart() - Programs and starts PIT channel 'ch'. The reload value
+ *  is assigned, never ORed, into LDVAL.
+ ******************************************************************************/
+void TimebasePitStart(INT8U ch, INT32U rate_hz){
+    INT32U ldval = TimebasePitLoad(rate_hz);
+
+    HalGateSet(HAL_SCGC6, SIM_SCGC6_PIT_MASK);  //Start SCGC6 clock for PIT
+    HalPitEnable();                             //Enable PIT via MCR
+
+    tbRates[ch].num = TB_BUS_CLOCK;
+    tbRates[ch].den = ldval + 1u;
+    HalPitRun(ch, FALSE);
+    HalPitLoadSet(ch, ldval);
+    HalPitRun(ch, TRUE);
+}
+
+/******************************************************************************
+ * TimebasePitStop() - Stops PIT channel 'ch'
+ ******************************************************************************/
+void TimebasePitStop(INT8U ch){
+    HalPitRun(ch, FALSE);
+}
+
+/******************************************************************************
+ * TimebaseRateGet() - Returns the achieved rate of PIT channel 'ch'
+ ******************************************************************************/
+TB_RATE TimebaseRateGet(INT8U ch){
+    return tbRates[ch];
+}
+
+/******************************************************************************
+ * TimebaseRateHz() - Achieved rate of 'ch' rounded to the nearest Hz
+ ******************************************************************************/
+INT32U TimebaseRateHz(INT8U ch){
+    return (tbRates[ch].num + (tbRates[ch].den/2u))/tbRates[ch].den;
+}
@@ -0,0 +1,52 @@
+/********************************************************************
+* Timebase.h - Header file for the timebase module
+* Owns the bus clock and every PIT reload value. Sample rates are
+* published as the exact rational the hardware achieves,
+* rate = num/den Hz, instead of the rate that was asked for.
+*
+* agent, 10/18/2026
+********************************************************************/
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+#define TB_BUS_CLOCK 60000000u              //Bus clock in Hz, clocks the PIT and ADC
+#define TB_CORE_CLOCK DEFAULT_SYSTEM_CLOCK  //Core clock in Hz
+
+//PIT channel assignments
+#define TB_PIT_DAC 0u           //PIT0 paces the DAC DMA
+#define TB_PIT_ADC 1u           //PIT1 triggers ADC0
+#define TB_PIT_NUM 2u
+
+//Achieved rate in Hz = num/den
+typedef struct{
+    INT32U num;
+    INT32U den;
+} TB_RATE;
+
+/******************************************************************************
+ * TimebasePitLoad() - PIT reload value that comes closest to 'rate_hz'
+ ******************************************************************************/
+INT32U TimebasePitLoad(INT32U rate_hz);
+
+/******************************************************************************
+ * TimebasePitStart() - Programs PIT channel 'ch' for 'rate_hz' and starts it.
+ *  Enables the PIT module if it is not already running.
+ ******************************************************************************/
+void TimebasePitStart(INT8U ch, INT32U rate_hz);
+
+/******************************************************************************
+ * TimebasePitStop() - Stops PIT channel 'ch'
+ ******************************************************************************/
+void TimebasePitStop(INT8U ch);
+
+/******************************************************************************
+ * TimebaseRateGet() - Returns the achieved rate of PIT channel 'ch'
+ ******************************************************************************/
+TB_RATE TimebaseRateGet(INT8U ch);
+
+/******************************************************************************
+ * TimebaseRateHz() - Achieved rate of 'ch' rounded to the nearest Hz
+ ******************************************************************************/
+INT32U TimebaseRateHz(INT8U ch);
+
+#endif
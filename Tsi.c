@@ -9,6 +9,7 @@
 #include "MCUType.h"
 #include "os.h"
 #include "app_cfg.h"
+#include "Hal.h"
 #include "K65TWR_GPIO.h"
 #include "Wave.h"
 #include "Tsi.h"
@@ -59,17 +60,17 @@ void TsiInit(void){
     OS_ERR os_err;
 
     /* Initialization of electrodes */
-    SIM_SCGC5 |= SIM_SCGC5_PORTB_MASK;                             /* Enables the clock for PORTB */
-    SIM_SCGC5 |= SIM_SCGC5_TSI_MASK;                               /* Enables the clock for TSI */
-    PORTB_PCR18 &= ~PORT_PCR_MUX_MASK;                             /* Disables the PORTB pin for electrode 2 */
-    PORTB_PCR19 &= ~PORT_PCR_MUX_MASK;                             /* Disables the PORTB pin for electrode 1 */
-    TSI0_GENCS |= TSI_GENCS_REFCHRG(5);
-    TSI0_GENCS |= TSI_GENCS_DVOLT(1);
-    TSI0_GENCS |= TSI_GENCS_EXTCHRG(5);
-    TSI0_GENCS |= TSI_GENCS_PS(5);
-    TSI0_GENCS |= TSI_GENCS_NSCN(15);
-    TSI0_GENCS |= TSI_GENCS_TSIEN(1);
-    TSI0_GENCS &= ~TSI_GENCS_STM(1);
+    HalGateSet(HAL_SCGC5, SIM_SCGC5_PORTB_MASK);                   /* Enables the clock for PORTB */
+    HalGateSet(HAL_SCGC5, SIM_SCGC5_TSI_MASK);                     /* Enables the clock for TSI */
+    HalPinCfgSet(HAL_PORTB, 18, HalPinCfgGet(HAL_PORTB, 18) & ~PORT_PCR_MUX_MASK);    /* Disables the PORTB pin for electrode 2 */
+    HalPinCfgSet(HAL_PORTB, 19, HalPinCfgGet(HAL_PORTB, 19) & ~PORT_PCR_MUX_MASK);    /* Disables the PORTB pin for electrode 1 */
+    HalTsiCfgSet(HalTsiCfgGet() | TSI_GENCS_REFCHRG(5));
+    HalTsiCfgSet(HalTsiCfgGet() | TSI_GENCS_DVOLT(1));
+    HalTsiCfgSet(HalTsiCfgGet() | TSI_GENCS_EXTCHRG(5));
+    HalTsiCfgSet(HalTsiCfgGet() | TSI_GENCS_PS(5));
+    HalTsiCfgSet(HalTsiCfgGet() | TSI_GENCS_NSCN(15));
+    HalTsiCfgSet(HalTsiCfgGet() | TSI_GENCS_TSIEN(1));
+    HalTsiCfgSet(HalTsiCfgGet() & ~TSI_GENCS_STM(1));
     NewVoltage.amp = 20u;                                                /* Initializes step to 20 */
 
     /* Task creation for TSI Task */
@@ -91,18 +92,16 @@ void TsiInit(void){
     while(os_err != OS_ERR_NONE){}
 
     /* Morton's code to set touch level offsets: Electrode 1 */
-    TSI0_DATA = TSI_DATA_TSICH(12);                                 //TSI0_CH12 is ELECTRODE1
-    TSI0_DATA |= TSI_DATA_SWTS(1);                                  //start a scan sequence
-    while(!(TSI0_GENCS & TSI_GENCS_EOSF_MASK)){}                    //wait for scan to finish
-    TSI0_GENCS |= TSI_GENCS_EOSF(1);                                //Clear scan flag
-    tsiBaselineLevels[ELECTRODE1] = (INT16U)(TSI0_DATA & TSI_DATA_TSICNT_MASK);
+    HalTsiScan(12);                                                 //TSI0_CH12 is ELECTRODE1, start a scan sequence
+    while(!HalTsiScanDone()){}                                      //wait for scan to finish
+    HalTsiScanDoneClear();                                          //Clear scan flag
+    tsiBaselineLevels[ELECTRODE1] = HalTsiCount();
     tsiTouchLevels[ELECTRODE1] = tsiBaselineLevels[ELECTRODE1] + E1_TOUCH_OFFSET;
     /* Electrode 2 */
-    TSI0_DATA = TSI_DATA_TSICH(11);                                 //TSI0_CH11 is ELECTRODE2
-    TSI0_DATA |= TSI_DATA_SWTS(1);                                  //start a scan sequence
-    while(!(TSI0_GENCS & TSI_GENCS_EOSF_MASK)){}                    //wait for scan to finish
-    TSI0_GENCS |= TSI_GENCS_EOSF(1);                                //Clear scan flag
-    tsiBaselineLevels[ELECTRODE2] = (INT16U)(TSI0_DATA & TSI_DATA_TSICNT_MASK);
+    HalTsiScan(11);                                                 //TSI0_CH11 is ELECTRODE2, start a scan sequence
+    while(!HalTsiScanDone()){}                                      //wait for scan to finish
+    HalTsiScanDoneClear();                                          //Clear scan flag
+    tsiBaselineLevels[ELECTRODE2] = HalTsiCount();
     tsiTouchLevels[ELECTRODE2] = tsiBaselineLevels[ELECTRODE2] + E2_TOUCH_OFFSET;
 
 }
@@ -131,12 +130,11 @@ static void TsiTask(void *p_arg){
 
 
         /*Start sequence for Electrode 1 */
-        TSI0_DATA = TSI_DATA_TSICH(12);
-        TSI0_DATA |= TSI_DATA_SWTS(1);
+        HalTsiScan(12);
 
 
         /* If left electrode has been pressed, increment amplitude */
-        if( ((INT16U)(TSI0_DATA & TSI_DATA_TSICNT_MASK) > tsiTouchLevels[ELECTRODE1]) && (NewVoltage.amp < MAX_STEP)){
+        if((HalTsiCount() > tsiTouchLevels[ELECTRODE1]) && (NewVoltage.amp < MAX_STEP)){
             if(leftBounce == 0){
             	NewVoltage.amp = NewVoltage.amp + STEP_SIZE;
             }
@@ -155,11 +153,10 @@ static void TsiTask(void *p_arg){
 
 
         /*Start sequence for Electrode 2 */
-        TSI0_DATA = TSI_DATA_TSICH(11);
-        TSI0_DATA |= TSI_DATA_SWTS(1);
+        HalTsiScan(11);
 
         /* If right electrode has been pressed, decrement amplitude */
-        if(((INT16U)(TSI0_DATA & TSI_DATA_TSICNT_MASK) > tsiTouchLevels[ELECTRODE2]) && (NewVoltage.amp > MIN_STEP)){
+        if((HalTsiCount() > tsiTouchLevels[ELECTRODE2]) && (NewVoltage.amp > MIN_STEP)){
             if(rightBounce == 0){
             	NewVoltage.amp = NewVoltage.amp - STEP_SIZE;
             }
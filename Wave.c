@@ -11,24 +11,32 @@
 #include "MCUType.h"
 #include "app_cfg.h"
 #include "os.h"
+#include "Hal.h"
 #include "K65TWR_GPIO.h"
 #include "DMA.h"
+#include "Timebase.h"
+#include "WaveTable.h"
+#include "Additive.h"
+#include "Profile.h"
+#include "Loopback.h"
 #include "Wave.h"
-#include "DMA.h"
 
-#define SINE 1          /* WaveStruct.type value for sine wave */
-#define TRIANGLE 2      /* WaveStruct.type value for triangle wave */
 #define DC_OFFSET 680  /* DC offset of 0.6 V - FOR A 1.6 VREF*/
 #define AC_MAX 570     /* AC offset of 0.5 V - FOR A 1.6 VREF*/
 #define MAX_STEP 20     /* Maximum step size for amplitude */
 #define MIN_STEP 0      /* Minimum step size for amplitude */
-#define FS 48000        /* Sample rate of PIT and sinewave */
-#define SINE_MAX_BIT_SHIFT 10      /* The largest right shift needed to prevent rollover */
-#define SINE_CONVERT_BIT_SHIFT 21  /* Bit shift required to convert from q31_t to INT16U */
-#define HALF_WAVE 1073527076          /* Q31 value for the first half of a wave period */
-#define FULL_WAVE 2147268899          /* Q31 value for the second half of a wave period */
-#define TOTAL_BUFFER_LAYERS 2      /* The amount of layers in the ping-pong buffer */
-#define BUFFER_SIZE 60             /* The size of the ping-pong buffer */
+#define WAVE_SINE_BITS 8           /* log2 of the sine table length */
+#define WAVE_SINE_SIZE (1u << WAVE_SINE_BITS)
+#define WAVE_FREQ_Q 8              /* Fraction bits of frequencies passed to WavePhaseInc() */
+#define WAVE_TYPE_SHIFT 0          /* Field positions in WaveWord */
+#define WAVE_AMP_SHIFT 8
+#define WAVE_FREQ_SHIFT 16
+#define WAVE_TYPE_MASK (0xFFu << WAVE_TYPE_SHIFT)
+#define WAVE_AMP_MASK (0xFFu << WAVE_AMP_SHIFT)
+#define WAVE_FREQ_MASK (0xFFFFu << WAVE_FREQ_SHIFT)
+#define WAVE_GLIDE_MS 10u          /* Frequency and amplitude ramp time */
+#define WAVE_LOOP_MAX 2048u       /* Longest DMA loop table in samples */
+#define WAVE_LOOP_TOL_Q8 3u        /* Loop frequency error allowed, 3/256 = 0.012 Hz */
 /*****************************************************************************************
 * Allocate task control blocks
 *****************************************************************************************/
@@ -42,29 +50,108 @@ static CPU_STK WaveTaskStk[APP_CFG_WAVE_TASK_STK_SIZE];
 /*********************************************************************
 * MicroC/OS Resources
 ********************************************************************/
-static OS_MUTEX WaveStructMutexKey;
 static OS_SEM WaveChgFlag;
 /*********************************************************************
 * Private Resources
 ********************************************************************/
-static WAVE_T WaveStruct;
-static INT16U WaveOut[TOTAL_BUFFER_LAYERS][BUFFER_SIZE];
-typedef enum{POS_WAVE, NEG_WAVE} TRI_T;
+/* WAVE_T packed in one word so it is read with a single load and never
+ * torn. The setters update their field with an exclusive access loop. */
+static volatile INT32U WaveWord;
+static INT16U WaveOut[DMA_RING_BLOCKS][DMA_RING_BLOCK_SAMPLES] __attribute__((aligned(DMA_RING_BYTES)));
+static INT32U WaveBlockPhase[DMA_RING_BLOCKS];     /* Sine phase at the end of each block */
+
+/* Q15 generator for one sample at 'phase', 'inc' is the phase step for band limiting */
+typedef INT32S (*WAVE_FN)(INT32U phase, INT32U inc);
+
+/* Generator state carried from one block to the next. phase_inc and vol
+ * ramp linearly to their targets over WAVE_GLIDE_MS, one add per sample. */
+typedef struct{
+    INT32U phase;           /* DDS phase accumulator, 2^32 is a full period */
+    INT32U phase_inc;       /* Phase step per sample, ramping */
+    INT32U inc_target;      /* Phase step for inc_freq */
+    INT32S inc_step;        /* Added to phase_inc each ramp sample */
+    INT32S vol;             /* Peak in DAC counts, Q16, ramping */
+    INT32S vol_target;
+    INT32S vol_step;        /* Added to vol each ramp sample */
+    INT32U ramp_left;       /* Samples left in the ramp, 0 when settled */
+    INT16U inc_freq;        /* Frequency inc_target was computed for */
+} WAVE_GEN;
+static WAVE_GEN WaveGen = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+/* DMA loop table and the phase it starts and ends on */
+static INT16U WaveLoopTbl[WAVE_LOOP_MAX];
+static INT32U WaveLoopPhase;
+
+/* One Q15 sine period. The extra entry repeats [0] so interpolation never wraps */
+static const INT16S WaveSineTbl[WAVE_SINE_SIZE + 1] = {
+    0, 804, 1608, 2410, 3212, 4011, 4808, 5602,
+    6393, 7179, 7962, 8739, 9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+    32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767, 32757, 32728, 32678, 32609, 32521, 32412, 32285,
+    32137, 31971, 31785, 31580, 31356, 31113, 30852, 30571,
+    30273, 29956, 29621, 29268, 28898, 28510, 28105, 27683,
+    27245, 26790, 26319, 25832, 25329, 24811, 24279, 23731,
+    23170, 22594, 22005, 21403, 20787, 20159, 19519, 18868,
+    18204, 17530, 16846, 16151, 15446, 14732, 14010, 13279,
+    12539, 11793, 11039, 10278, 9512, 8739, 7962, 7179,
+    6393, 5602, 4808, 4011, 3212, 2410, 1608, 804,
+    0, -804, -1608, -2410, -3212, -4011, -4808, -5602,
+    -6393, -7179, -7962, -8739, -9512, -10278, -11039, -11793,
+    -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530,
+    -18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+    -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+    -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+    -30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971,
+    -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+    -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285,
+    -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+    -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+    -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+    -23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868,
+    -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+    -12539, -11793, -11039, -10278, -9512, -8739, -7962, -7179,
+    -6393, -5602, -4808, -4011, -3212, -2410, -1608, -804,
+    0
+};
 
 /******************************************************************************
  * Private Task Function Prototypes
  ******************************************************************************/
 static void WaveTask(void *p_arg);
+static void WaveRead(WAVE_T *wave);
+static void WaveWrite(INT32U mask, INT32U value);
+static INT8U WaveSame(const WAVE_T *a, const WAVE_T *b);
+static void WaveFill(INT16U *block, const WAVE_T *wave);
+static void WaveRampSet(const WAVE_T *wave);
+static INT16U WaveLoopFit(INT32U freq_q, INT16U *periods);
+static INT8U WaveLoopStart(const WAVE_T *wave, INT32U phase, INT8U block);
+static INT32U WavePhaseInc(INT32U freq_q);
+static INT32S WaveSine(INT32U phase);
+static INT32S WaveSineGen(INT32U phase, INT32U inc);
+static INT32S WaveTriangle(INT32U phase, INT32U inc);
+static INT32S WaveSaw(INT32U phase, INT32U inc);
+static INT32S WaveSquare(INT32U phase, INT32U inc);
+static INT32S WaveSilent(INT32U phase, INT32U inc);
+static INT32S WaveBlep(INT32U t, INT32U dt);
+static WAVE_FN WaveFnGet(INT8U type);
 
 /******************************************************************************
- * WaveInit() - Creates WaveTask, the Wave Struck Mutex, and the Wave Change Flag.
+ * WaveInit() - Creates WaveTask and the Wave Change Flag.
  *
  *  02/13/2018 Maria Watters
  ******************************************************************************/
 void WaveInit(void){
     OS_ERR os_err;
+    TB_RATE dac;
 
-    WaveStruct.amp = 20u;
+    WaveWord = 20u << WAVE_AMP_SHIFT;
+    WaveTableInit();
+    AdditiveInit();
 
     /* Task creation for the Wave Task */
     OSTaskCreate(&WaveTaskTCB,
@@ -84,19 +171,24 @@ void WaveInit(void){
     /* Error Trap */
     while(os_err != OS_ERR_NONE){}
 
-    OSMutexCreate(&WaveStructMutexKey, "Wave Struct Mutex ", &os_err);
-    while(os_err != OS_ERR_NONE){}
-
     OSSemCreate(&WaveChgFlag, "Wave Change Flag Semaphore", 0, &os_err);
     while(os_err != OS_ERR_NONE){  }
 
     (void)DMAInit(&WaveOut[0][0]);
+    AdditiveBudgetMeasure(DMA_RING_BLOCK_SAMPLES, TimebaseRateHz(TB_PIT_DAC));
+
+    /* A block released by the DMA is needed again once the other ring blocks have played */
+    dac = TimebaseRateGet(TB_PIT_DAC);
+    ProfileDeadlineSet(PROF_WAVE, (INT32U)(((INT64U)TB_CORE_CLOCK*(DMA_RING_BLOCKS - 1u)*
+                                            DMA_RING_BLOCK_SAMPLES*dac.den)/dac.num));
 }
 
 /******************************************************************************
  * WaveTask() - Generates the waveform to be output by the DMA/DAC. The waveform
  *  generated depends on the inputed frequency (10 Hz - 10 kHz), amplitude
  *  (0 - 1 Vpp), and waveform type (triangle or sine).
+ *  A steady wave is handed to the DMA as a looping wavetable, after which the
+ *  task sleeps until one of the setters posts its task semaphore.
  *
  *  2/15/2018 Maria Watters, Daniel Dodge, Daniel Wilson
  ******************************************************************************/
@@ -104,194 +196,533 @@ static void WaveTask(void *p_arg){
     OS_ERR os_err;
     (void)p_arg;
     WAVE_T CurrentStruct;
-    TRI_T Wave_State;
-    INT16U volume;
-    INT8U changeState = 1;
-    INT8U wave_index;
-    INT32S ac_component;
+    WAVE_T LoopStruct;          /* Parameters the DMA loop was rendered for */
+    WAVE_T PrevStruct = {0, 0, 0};
+    INT8U steady = 0;           /* Blocks in a row rendered with PrevStruct */
     INT8U buffer_layer;
-    q31_t radians = 0;
-    INT32S sin_val;
-    INT32S tri_val;
-
+    INT8U playing;
+    INT8U looping = 0;
 
     while(1){
 
         DB4_TURN_OFF();
-        /* Update which 'ping-pong' layer to write to for the DMA */
-        DMAPend(&buffer_layer);
+        if(looping == 0){
+            /* Update which ring block to write to for the DMA */
+            DMAPend(&buffer_layer);
+            ProfileBegin(PROF_WAVE);
+        }else{
+            /* The DMA plays the table by itself, only a parameter change wakes us */
+            OSTaskSemPend(0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+            while(os_err != OS_ERR_NONE){ }
+        }
+
+        WaveRead(&CurrentStruct);
+
+        DB3_TURN_ON();
+
+        if(looping != 0){
+            if((WaveSame(&CurrentStruct, &LoopStruct) == FALSE) || (LoopbackActive() != FALSE)){
+                /* The table ends on the phase it started at, carry on from there */
+                WaveGen.phase = WaveLoopPhase;
+                /* The ring restarts at block [0], so the tap gets them in play order */
+                for(buffer_layer = 0; buffer_layer < DMA_RING_BLOCKS; buffer_layer++){
+                    WaveFill(&WaveOut[buffer_layer][0], &CurrentStruct);
+                    WaveBlockPhase[buffer_layer] = WaveGen.phase;
+                    LoopbackPush(&WaveOut[buffer_layer][0], DMA_RING_BLOCK_SAMPLES);
+                }
+                DMALoopExit();
+                looping = 0;
+                PrevStruct = CurrentStruct;
+                steady = 0;
+            }else{}
+        }else{
+            WaveFill(&WaveOut[buffer_layer][0], &CurrentStruct);
+            WaveBlockPhase[buffer_layer] = WaveGen.phase;
+            DMABlockDone(buffer_layer);
+            ProfileEnd(PROF_WAVE);
+            LoopbackPush(&WaveOut[buffer_layer][0], DMA_RING_BLOCK_SAMPLES);
+            if(WaveSame(&CurrentStruct, &PrevStruct) == FALSE){
+                PrevStruct = CurrentStruct;
+                steady = 0;
+            }else{}
+            if(WaveGen.ramp_left != 0){
+                steady = 0;             /* Only settled blocks can lead into the loop */
+            }else if(steady <= DMA_RING_BLOCKS){
+                steady++;
+            }else{}
+
+            /* Loop once every block in the ring has the same wave. The table
+             * takes over after the block playing now, from its end phase.
+             * Partials with ratios that are not whole never repeat, so the
+             * additive mode always streams, and so does the loopback, which
+             * needs every block. */
+            if((steady == DMA_RING_BLOCKS) && (CurrentStruct.type != ADDITIVE) &&
+               (LoopbackActive() == FALSE)){
+                playing = (INT8U)((buffer_layer + 1u) % DMA_RING_BLOCKS);
+                looping = WaveLoopStart(&CurrentStruct, WaveBlockPhase[playing], playing);
+                if(looping != 0){
+                    LoopStruct = CurrentStruct;
+                    /* Catch a change that slipped in before the semaphore was cleared */
+                    (void)OSTaskSemSet(&WaveTaskTCB, 0, &os_err);
+                    while(os_err != OS_ERR_NONE){ }
+                    WaveRead(&CurrentStruct);
+                    if(WaveSame(&CurrentStruct, &LoopStruct) == FALSE){
+                        (void)OSTaskSemPost(&WaveTaskTCB, OS_OPT_POST_NONE, &os_err);
+                    }else{}
+                }else{}
+            }else{}
+        }
+    }
+}
+
+/********************************************************************
+* WaveRead() - Unpacks WaveWord into *wave. One load, so it never blocks
+*   and always sees a complete set of parameters.
+********************************************************************/
+static void WaveRead(WAVE_T *wave){
+    INT32U word = WaveWord;
 
-        /* Grab the Wave Struct Mutex Key */
-        OSMutexPend(&WaveStructMutexKey, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
-        while(os_err != OS_ERR_NONE){ }
+    wave->type = (INT8U)((word & WAVE_TYPE_MASK) >> WAVE_TYPE_SHIFT);
+    wave->amp = (INT8U)((word & WAVE_AMP_MASK) >> WAVE_AMP_SHIFT);
+    wave->freq = (INT16U)((word & WAVE_FREQ_MASK) >> WAVE_FREQ_SHIFT);
+}
 
-        CurrentStruct = WaveStruct;
+/********************************************************************
+* WaveWrite() - Replaces the 'mask' field of WaveWord with 'value'.
+*   LDREX/STREX retries if another writer got in between, so both the
+*   UI and TSI tasks can set parameters without a lock.
+********************************************************************/
+static void WaveWrite(INT32U mask, INT32U value){
+    INT32U word;
 
-        /* Release the Mutex Key */
-        OSMutexPost(&WaveStructMutexKey, OS_OPT_POST_NONE, &os_err);
-        while(os_err != OS_ERR_NONE){ }
+    do{
+        word = __LDREXW(&WaveWord);
+        word = (word & ~mask) | (value & mask);
+    }while(__STREXW(word, &WaveWord) != 0u);
+}
 
-        DB3_TURN_ON();
+/********************************************************************
+* WaveSame() - TRUE if both waves have the same type, amp and freq
+********************************************************************/
+static INT8U WaveSame(const WAVE_T *a, const WAVE_T *b){
+    INT8U same;
 
-        /* Waveform generator */
-        if(CurrentStruct.amp == MIN_STEP){
-            for(wave_index = 0; wave_index < BUFFER_SIZE; wave_index++){
-                WaveOut[buffer_layer][wave_index] = DC_OFFSET;
+    if((a->type == b->type) && (a->amp == b->amp) && (a->freq == b->freq)){
+        same = TRUE;
+    }else{
+        same = FALSE;
+    }
+    return same;
+}
+
+/********************************************************************
+* WaveFill() - Renders one ring block of 'wave' into *block,
+*   continuing from the generator state left by the previous block.
+*   Every type is a function of the one DDS phase accumulator. While a
+*   ramp is running the block is split where it ends, so the sample
+*   loop stays the same and the steps are just zero afterwards.
+********************************************************************/
+static void WaveFill(INT16U *block, const WAVE_T *wave){
+    INT16U wave_index = 0;
+    INT16U seg_end;
+    INT32S ac_component;
+    INT32U mid_steps;
+    WAVE_FN gen = WaveFnGet(wave->type);
+
+    WaveRampSet(wave);
+    /* The partials run at one rate per block, so seed them with the
+       fundamental the ramp reaches half way through the block */
+    if(wave->type == ADDITIVE){
+        mid_steps = (WaveGen.ramp_left < (DMA_RING_BLOCK_SAMPLES/2u)) ? WaveGen.ramp_left : (DMA_RING_BLOCK_SAMPLES/2u);
+        AdditiveBlockStart(WaveGen.phase_inc + (INT32U)(WaveGen.inc_step*(INT32S)mid_steps), DMA_RING_BLOCK_SAMPLES);
+    }else{}
+
+    /* Waveform generator */
+    if((WaveGen.vol == 0) && (WaveGen.ramp_left == 0)){
+        for(wave_index = 0; wave_index < DMA_RING_BLOCK_SAMPLES; wave_index++){
+            block[wave_index] = DC_OFFSET;
+        }
+    }else{
+        while(wave_index < DMA_RING_BLOCK_SAMPLES){
+            if(WaveGen.ramp_left < (INT32U)(DMA_RING_BLOCK_SAMPLES - wave_index)){
+                seg_end = (INT16U)(wave_index + WaveGen.ramp_left);
+            }else{
+                seg_end = DMA_RING_BLOCK_SAMPLES;
             }
+            if(seg_end == wave_index){
+                seg_end = DMA_RING_BLOCK_SAMPLES;   /* Settled, steps are zero */
+            }else{
+                WaveGen.ramp_left = WaveGen.ramp_left - (seg_end - wave_index);
+            }
+            for(; wave_index < seg_end; wave_index++){
+                WaveGen.phase_inc = WaveGen.phase_inc + (INT32U)WaveGen.inc_step;
+                WaveGen.vol = WaveGen.vol + WaveGen.vol_step;
+                WaveGen.phase = WaveGen.phase + WaveGen.phase_inc;
+                ac_component = ((WaveGen.vol >> 16)*gen(WaveGen.phase, WaveGen.phase_inc)) >> 15;
+                block[wave_index] = (INT16U)(DC_OFFSET + ac_component);
+            }
+            /* Land exactly on the targets, the steps were truncated */
+            if(WaveGen.ramp_left == 0){
+                WaveGen.phase_inc = WaveGen.inc_target;
+                WaveGen.vol = WaveGen.vol_target;
+                WaveGen.inc_step = 0;
+                WaveGen.vol_step = 0;
+            }else{}
+        }
+    }
+}
+
+/********************************************************************
+* WaveRampSet() - Starts a new ramp from the current phase step and
+*   volume when 'wave' changes either target. The phase step only
+*   changes with the frequency, so the divide runs once per change.
+********************************************************************/
+static void WaveRampSet(const WAVE_T *wave){
+    INT32S vol_target;
+    INT32S glide;
+    INT8U changed = FALSE;
+
+    if(wave->freq != WaveGen.inc_freq){
+        WaveGen.inc_freq = wave->freq;
+        WaveGen.inc_target = WavePhaseInc((INT32U)WaveGen.inc_freq << WAVE_FREQ_Q);
+        changed = TRUE;
+    }else{}
+    vol_target = (INT32S)((((INT32U)wave->amp*AC_MAX)/MAX_STEP) << 16);
+    if(vol_target != WaveGen.vol_target){
+        WaveGen.vol_target = vol_target;
+        changed = TRUE;
+    }else{}
+    if(changed != FALSE){
+        glide = (INT32S)((WAVE_GLIDE_MS*TimebaseRateHz(TB_PIT_DAC))/1000u);
+        WaveGen.ramp_left = (INT32U)glide;
+        WaveGen.inc_step = (INT32S)(WaveGen.inc_target - WaveGen.phase_inc)/glide;
+        WaveGen.vol_step = (WaveGen.vol_target - WaveGen.vol)/glide;
+    }else{}
+}
+
+/********************************************************************
+* WaveLoopFit() - Finds the table length L <= WAVE_LOOP_MAX holding a
+*   whole number of periods, *periods, whose frequency periods*fs/L is
+*   closest to freq_q/2^8 Hz. This is the best rational approximation of
+*   f/fs, taken from its continued fraction. Returns 0 if even the best
+*   one is more than WAVE_LOOP_TOL_Q8 off.
+********************************************************************/
+static INT16U WaveLoopFit(INT32U freq_q, INT16U *periods){
+    TB_RATE fs = TimebaseRateGet(TB_PIT_DAC);
+    INT64U a = (INT64U)freq_q*fs.den;            /* f/fs = a/b */
+    INT64U b = (INT64U)fs.num << WAVE_FREQ_Q;
+    INT64U x = a;
+    INT64U y = b;
+    INT64U t;
+    INT64U r;
+    INT32U p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+    INT32U p2, q2;
+    INT32U cand_p[2];
+    INT32U cand_q[2];
+    INT64U err[2];
+    INT8U i;
+    INT16U len = 0;
+
+    /* Convergents p1/q1 up to the length limit */
+    cand_p[1] = 0;
+    cand_q[1] = 0;
+    while(y != 0){
+        t = x/y;
+        if((q1 != 0) && (t > (INT64U)((WAVE_LOOP_MAX - q0)/q1))){
+            /* Next convergent is too long, the best semiconvergent may still beat p1/q1 */
+            t = (WAVE_LOOP_MAX - q0)/q1;
+            cand_p[1] = p0 + (INT32U)t*p1;
+            cand_q[1] = q0 + (INT32U)t*q1;
+            break;
+        }else{}
+        p2 = (INT32U)t*p1 + p0;
+        q2 = (INT32U)t*q1 + q0;
+        p0 = p1;
+        q0 = q1;
+        p1 = p2;
+        q1 = q2;
+        r = x - t*y;
+        x = y;
+        y = r;
+    }
+    cand_p[0] = p1;
+    cand_q[0] = q1;
+
+    /* Error of each candidate, scaled by den*L, against the tolerance */
+    for(i = 0; i < 2u; i++){
+        if((cand_p[i] == 0) || (cand_q[i] == 0)){
+            err[i] = 0xFFFFFFFFFFFFFFFFu;
         }else{
-            volume = ((CurrentStruct.amp) *AC_MAX) /MAX_STEP;
-            switch(CurrentStruct.type){
-            case SINE:
-                for(wave_index = 0; wave_index < BUFFER_SIZE; wave_index++){
+            err[i] = (cand_p[i]*b > a*cand_q[i]) ? (cand_p[i]*b - a*cand_q[i]) : (a*cand_q[i] - cand_p[i]*b);
+            if(err[i] > ((INT64U)WAVE_LOOP_TOL_Q8*fs.den*cand_q[i])){
+                err[i] = 0xFFFFFFFFFFFFFFFFu;
+            }else{}
+        }
+    }
+    if(err[0] != 0xFFFFFFFFFFFFFFFFu){
+        if((err[1] != 0xFFFFFFFFFFFFFFFFu) && ((err[1]*cand_q[0]) < (err[0]*cand_q[1]))){
+            i = 1;
+        }else{
+            i = 0;
+        }
+    }else if(err[1] != 0xFFFFFFFFFFFFFFFFu){
+        i = 1;
+    }else{
+        i = 2;
+    }
+    if(i < 2u){
+        *periods = (INT16U)cand_p[i];
+        len = (INT16U)cand_q[i];
+    }else{}
+    return len;
+}
 
-                    radians = radians + ( (((INT32S)(CurrentStruct.freq)<<17)/FS )<<14);  //radian index
+/********************************************************************
+* WaveLoopStart() - Renders 'wave' into WaveLoopTbl as a whole number of
+*   periods starting from 'phase', the end of ring block 'block', and hands
+*   it to the DMA to play after that block. Each sample steps the phase by periods*2^32/L with the remainder
+*   carried exactly, so the table ends on the phase it began at.
+*   Returns TRUE if the DMA is now set to loop the table.
+********************************************************************/
+static INT8U WaveLoopStart(const WAVE_T *wave, INT32U phase, INT8U block){
+    INT16U len;
+    INT16U periods;
+    INT16U i;
+    INT64U span;
+    INT32U inc;
+    INT32U rem;
+    INT32U acc = 0;
+    INT16U volume = 0;
+    INT8U looping = FALSE;
+    WAVE_FN gen = WaveFnGet(wave->type);
+
+    len = WaveLoopFit((INT32U)wave->freq << WAVE_FREQ_Q, &periods);
+    if(len != 0){
+        span = (INT64U)periods << 32;
+        inc = (INT32U)(span/len);
+        rem = (INT32U)(span%len);
+        if(wave->amp != MIN_STEP){
+            volume = ((wave->amp) *AC_MAX) /MAX_STEP;
+        }else{}
+        for(i = 0; i < len; i++){
+            phase = phase + inc;
+            acc = acc + rem;
+            if(acc >= len){
+                acc = acc - len;
+                phase++;
+            }else{}
+            WaveLoopTbl[i] = (INT16U)(DC_OFFSET + ((volume*gen(phase, inc)) >> 15));
+        }
+        WaveLoopPhase = phase;
+        looping = DMALoopStart(&WaveLoopTbl[0], len, block);
+    }else{}
+    return looping;
+}
 
-                    if((radians & 0x80000000) == 0x80000000){
-                        radians = ~radians;
-                        radians = (2147268900) - radians;
-                    }else{}
+/********************************************************************
+* WavePhaseInc() - 32 bit DDS phase step for a frequency of freq_q/2^8 Hz
+*   at the achieved DAC rate, step = freq*2^32*den/num. Fractional Hz
+*   are kept, so the resolution is set by the accumulator, 11uHz.
+********************************************************************/
+static INT32U WavePhaseInc(INT32U freq_q){
+    TB_RATE fs = TimebaseRateGet(TB_PIT_DAC);
 
-                    sin_val = arm_sin_q31(radians);
-//                    ac_component =  (((volume/2)*(sin_val>>11))>>20);
-                    ac_component =  (((volume)*(sin_val>>11))>>20);
-                    /* bit shift right to convert to INT16U from q31_t*/
-                    WaveOut[buffer_layer][wave_index] = (INT16U)(DC_OFFSET + ac_component);
+    return (INT32U)((((INT64U)freq_q << (32 - WAVE_FREQ_Q))*fs.den)/fs.num);
+}
 
-                    }
-                break;
+/********************************************************************
+* WaveSine() - Q15 sine of 'phase' from WaveSineTbl. The top 8 bits
+*   pick the entry, the next 16 bits interpolate linearly to the next.
+********************************************************************/
+static INT32S WaveSine(INT32U phase){
+    INT32U idx = phase >> (32 - WAVE_SINE_BITS);
+    INT32S frac = (INT32S)((phase >> (16 - WAVE_SINE_BITS)) & 0xFFFFu);
+    INT32S s0 = WaveSineTbl[idx];
 
-            case TRIANGLE:
-                for(wave_index = 0; wave_index < BUFFER_SIZE; wave_index++){
+    return s0 + (((WaveSineTbl[idx + 1] - s0)*frac) >> 16);
+}
 
-                	/* Calculates radian points for triangle wave */
-                    radians = radians + ( (((INT32S)(2 * CurrentStruct.freq)<<17)/FS )<<14);
+/********************************************************************
+* WaveSineGen() - WaveSine() as a WAVE_FN
+********************************************************************/
+static INT32S WaveSineGen(INT32U phase, INT32U inc){
+    (void)inc;
+    return WaveSine(phase);
+}
 
-                    if((radians & 0x80000000) == 0x80000000){
-                        radians = ~radians;
-                        radians = (2147268900) - radians;
-                    }else{}
+/********************************************************************
+* WaveTriangle() - Q15 triangle in phase with the sine. Shifting by a
+*   quarter turn puts the peak at the sign flip, where p^(p>>31)
+*   folds the second half back down. No branches, no compares.
+*   A triangle has no step, so it needs no band limiting.
+********************************************************************/
+static INT32S WaveTriangle(INT32U phase, INT32U inc){
+    INT32S p = (INT32S)(phase + 0x40000000u);
 
-                    if(radians <= HALF_WAVE){
-                        tri_val = radians;
-
-                        if(changeState == 1){
-                            changeState = 0;
-                            if(Wave_State == POS_WAVE){
-                                Wave_State = NEG_WAVE;
-                            }else{
-                                Wave_State = POS_WAVE;
-                            }
-                        }else{}
-                    }else{
-                        changeState = 1;
-                        tri_val = FULL_WAVE - radians;
-                    }
-
-                    //state machine to set positive and negative sides of wave
-                    switch(Wave_State){
-                    case POS_WAVE:
-                        break;
-                    case NEG_WAVE:
-                        tri_val = ~tri_val;
-                        break;
-                    default:
-
-                        break;
-                    }
-
-                    //sets wave amplitude
-                    ac_component =  ((volume*(tri_val>>11))>>20);
-                    WaveOut[buffer_layer][wave_index] = (INT16U)(DC_OFFSET + ac_component);
-                }
-                break;
-            default:
-                    break;
-            }
-        }
+    (void)inc;
+    return ((p ^ (p >> 31)) >> 15) - 32768;
+}
+
+/********************************************************************
+* WaveSaw() - Q15 rising sawtooth, 0 at phase 0 like the sine. The naive
+*   ramp is the top bits of the phase, its step at half a turn is
+*   smoothed by WaveBlep().
+********************************************************************/
+static INT32S WaveSaw(INT32U phase, INT32U inc){
+    INT32U t = phase + 0x80000000u;     /* Step at t = 0 */
+
+    return ((INT32S)(t >> 16) - 32768) - WaveBlep(t, inc);
+}
+
+/********************************************************************
+* WaveSquare() - Q15 square, high for the first half turn. The sign bit
+*   of the phase picks +/-1 without a branch, and both edges get a
+*   WaveBlep() correction.
+********************************************************************/
+static INT32S WaveSquare(INT32U phase, INT32U inc){
+    INT32S naive = (((INT32S)phase >> 31) | 1)*32767;
+
+    return naive + WaveBlep(phase, inc) - WaveBlep(phase + 0x80000000u, inc);
+}
+
+/********************************************************************
+* WaveSilent() - Flat output for an unknown type
+********************************************************************/
+static INT32S WaveSilent(INT32U phase, INT32U inc){
+    (void)phase;
+    (void)inc;
+    return 0;
+}
 
+/********************************************************************
+* WaveBlep() - Q15 PolyBLEP residual for a unit step at t = 0, where t
+*   and the phase step dt are in 2^32 per turn. It is only non zero
+*   within one sample of the step, so a float divide is paid twice a
+*   period at most.
+********************************************************************/
+static INT32S WaveBlep(INT32U t, INT32U dt){
+    FP32 x;
+    INT32S blep = 0;
+
+    if(t < dt){
+        x = (FP32)t/(FP32)dt;               /* Just after the step, 0..1 */
+        blep = (INT32S)((x + x - x*x - 1.0f)*32768.0f);
+    }else if(t > (0u - dt)){
+        x = (FP32)(INT32S)t/(FP32)dt;       /* Just before the step, -1..0 */
+        blep = (INT32S)((x*x + x + x + 1.0f)*32768.0f);
+    }else{}
+    return blep;
+}
 
+/********************************************************************
+* WaveFnGet() - Generator for a WAVE_T.type value
+********************************************************************/
+static WAVE_FN WaveFnGet(INT8U type){
+    WAVE_FN gen;
+
+    switch(type){
+    case SINE:
+        gen = WaveSineGen;
+        break;
+    case TRIANGLE:
+        gen = WaveTriangle;
+        break;
+    case SAWTOOTH:
+        gen = WaveSaw;
+        break;
+    case SQUARE:
+        gen = WaveSquare;
+        break;
+    case WAVETABLE:
+        gen = WaveTableSample;
+        break;
+    case ADDITIVE:
+        gen = AdditiveSample;
+        break;
+    default:
+        gen = WaveSilent;
+        break;
     }
+    return gen;
 }
 
 /********************************************************************
-* AmpSet() - Copies the adjusted amplitude to WaveStruct.amp via *lamp
-*   (local amplitude) by grabbing access to the Wave Struct via the
-*   Mutex.
+* AmpSet() - Copies the adjusted amplitude to the amp field of
+*   WaveWord via *lamp (local amplitude).
 * 2/13/2018 Maria Watters
 ********************************************************************/
 void AmpSet(INT8U *lamp){
     OS_ERR os_err;
 
-    /* Grab the Wave Struct Mutex Key */
-    OSMutexPend(&WaveStructMutexKey, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
-    while(os_err != OS_ERR_NONE){ }
-
     /* Override the former amplitude with the new amplitude */
-    WaveStruct.amp = *lamp;
-
-    /* Release the Mutex Key */
-    OSMutexPost(&WaveStructMutexKey, OS_OPT_POST_NONE, &os_err);
+    WaveWrite(WAVE_AMP_MASK, (INT32U)*lamp << WAVE_AMP_SHIFT);
     OSSemPost(&WaveChgFlag, OS_OPT_POST_1, &os_err);
     while(os_err != OS_ERR_NONE){ }
+    /* Wake WaveTask in case the DMA is looping */
+    (void)OSTaskSemPost(&WaveTaskTCB, OS_OPT_POST_NONE, &os_err);
+    while(os_err != OS_ERR_NONE){ }
 }
 
 /********************************************************************
-* FreqSet() - Copies the adjusted frequency to WaveStruct.amp via *lfreq
-*   (local frequency) by grabbing access to the Wave Struct via the
-*   Mutex.
+* FreqSet() - Copies the adjusted frequency to the freq field of
+*   WaveWord via *lfreq (local frequency).
 * 2/15/2018 Maria Watters
 ********************************************************************/
 void FreqSet(INT16U *lfreq){
     OS_ERR os_err;
 
-    /* Grab the Wave Struct Mutex Key */
-    OSMutexPend(&WaveStructMutexKey, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
-    while(os_err != OS_ERR_NONE){ }
-
-    /* Override the former amplitude with the new amplitude */
-    WaveStruct.freq = *lfreq;
-
-    /* Release the Mutex Key */
-    OSMutexPost(&WaveStructMutexKey, OS_OPT_POST_NONE, &os_err);
+    /* Override the former frequency with the new frequency */
+    WaveWrite(WAVE_FREQ_MASK, (INT32U)*lfreq << WAVE_FREQ_SHIFT);
     OSSemPost(&WaveChgFlag, OS_OPT_POST_1, &os_err);
     while(os_err != OS_ERR_NONE){ }
+    /* Wake WaveTask in case the DMA is looping */
+    (void)OSTaskSemPost(&WaveTaskTCB, OS_OPT_POST_NONE, &os_err);
+    while(os_err != OS_ERR_NONE){ }
 }
 
 /********************************************************************
-* TypeSet() - Copies the selected waveform type to WaveStruct.amp via
-*   *ltype (local frequency) by grabbing access to the Wave Struct via the
-*   Mutex.
+* TypeSet() - Copies the selected waveform type to the type field of
+*   WaveWord via *ltype (local type).
 * 2/15/2018 Maria Watters
 ********************************************************************/
 void TypeSet(INT8U *ltype){
     OS_ERR os_err;
 
-    /* Grab the Wave Struct Mutex Key */
-    OSMutexPend(&WaveStructMutexKey, 0, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &os_err);
+    /* Override the former type with the new type */
+    WaveWrite(WAVE_TYPE_MASK, (INT32U)*ltype << WAVE_TYPE_SHIFT);
+    /* Wake WaveTask in case the DMA is looping */
+    (void)OSTaskSemPost(&WaveTaskTCB, OS_OPT_POST_NONE, &os_err);
     while(os_err != OS_ERR_NONE){ }
+}
 
-    /* Override the former amplitude with the new amplitude */
-    WaveStruct.type = *ltype;
+/********************************************************************
+* WaveWake() - Posts WaveTask's own semaphore. In block streaming the
+*   count is cleared before the next loop attempt, so a spare post
+*   does no harm.
+********************************************************************/
+void WaveWake(void){
+    OS_ERR os_err;
 
-    /* Release the Mutex Key */
-    OSMutexPost(&WaveStructMutexKey, OS_OPT_POST_NONE, &os_err);
+    (void)OSTaskSemPost(&WaveTaskTCB, OS_OPT_POST_NONE, &os_err);
     while(os_err != OS_ERR_NONE){ }
 }
 
 /********************************************************************
-* WaveGet() - Copies WaveStruct.freq to *lfreq and WaveStruct.amp
-* to *lamp if the values have changed in the wave struct
+* WaveGet() - Copies the current freq to *lfreq and amp to *lamp
+* once a change has been signaled
 * 2/14/2018 Maria Watters
 ********************************************************************/
 void WaveGet(INT8U *lamp, INT16U *lfreq){
     OS_ERR os_err;
+    WAVE_T wave;
 
     /* Checks if change to Wave Struct has been signaled */
     OSSemPend(&WaveChgFlag,0,OS_OPT_PEND_BLOCKING,(CPU_TS *)0,&os_err);
     while(os_err != OS_ERR_NONE){ }
 
     /* Updates the element in the task that calls this function with the current value */
-    *lamp = WaveStruct.amp;
-    *lfreq = WaveStruct.freq;
+    WaveRead(&wave);
+    *lamp = wave.amp;
+    *lfreq = wave.freq;
 
 }
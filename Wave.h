@@ -8,6 +8,14 @@
 #ifndef SOURCES_WAVE_H_
 #define SOURCES_WAVE_H_
 
+/* WAVE_T.type values, selected with TypeSet() */
+#define SINE 1
+#define TRIANGLE 2
+#define SAWTOOTH 3
+#define SQUARE 4
+#define WAVETABLE 5
+#define ADDITIVE 6
+
 /* Global resources */
 typedef struct{
     INT8U type;
@@ -20,21 +28,26 @@ typedef struct{
  ******************************************************************************/
 void WaveInit(void);
 /********************************************************************
-* AmpSet() - Copies *lamp to WaveStruct.amp
+* AmpSet() - Copies *lamp to the wave amplitude
 ********************************************************************/
 void AmpSet(INT8U *lamp);
 /********************************************************************
-*FreqSet() - Copies *lfreq to WaveStruct.freq
+*FreqSet() - Copies *lfreq to the wave frequency
 ********************************************************************/
 void FreqSet(INT16U *lfreq);
 /********************************************************************
-* TypeSet() - Copies *ltype to WaveStruct.type
+* TypeSet() - Copies *ltype to the wave type
 ********************************************************************/
 void TypeSet(INT8U *ltype);
 /********************************************************************
-* WaveGet() - Copies WaveStruct.freq to *lfreq and WaveStruct.amp
-*   to *lamp if the values have changed in the wave struct
+* WaveGet() - Copies the wave frequency to *lfreq and amplitude
+*   to *lamp once a change has been signaled
 ********************************************************************/
 void WaveGet(INT8U *lamp, INT16U *lfreq);
+/********************************************************************
+* WaveWake() - Makes WaveTask look at its state again, e.g. to leave
+*   a DMA loop table when the loopback needs the block stream
+********************************************************************/
+void WaveWake(void);
 
 #endif /* SOURCES_WAVE_H_ */
@@ -0,0 +1,156 @@
+/********************************************************************
+* WaveTable.c - Mipmapped wavetable oscillator
+* Level l keeps harmonics 1..WT_SIZE/2^(l+1), the top one dropped
+* at level 0 to stay under the table's own Nyquist. The levels are
+* made once from the waveform's spectrum: one real FFT of the cycle,
+* then one inverse FFT per level with the upper bins cleared. The
+* FFT scratch is only needed while the levels are made, so it comes
+* out of the DSP arena before the analyzer takes the arena over.
+*
+* agent, 10/18/2026
+********************************************************************/
+#include "MCUType.h"
+#include "app_cfg.h"
+#include "DspArena.h"
+#include "WaveTable.h"
+
+#define WT_LEVEL0_BITS 23u          //Level 0 is clean for phase steps below 2^23
+#define WT_DEFAULT_HARMS 8u
+
+/* Compile-time check that DspArena.h budgets this module's scratch */
+typedef INT8U WT_ARENA_SIZE_CHECK[(DSP_WT_WORDS == (3u*WT_SIZE)) ? 1 : -1];
+
+/* Default timbre, a sine with a little of the soft odd and even overtones
+ * a heterodyne theremin adds. Amplitudes relative to the fundamental. */
+static const FP32 wtDefaultHarms[WT_DEFAULT_HARMS] = {
+    1.0f, 0.30f, 0.16f, 0.08f, 0.05f, 0.03f, 0.02f, 0.01f
+};
+
+/*********************************************************************
+* Private Resources
+********************************************************************/
+static INT16S wtLevels[WT_LEVELS][WT_SIZE + 1u];     //+1 repeats [0] for interpolation
+static arm_rfft_fast_instance_f32 wtFft;
+static FP32 *wtSpec;                //Packed real FFT of the cycle, bin k at [2k],[2k+1]
+static FP32 *wtWork;                //WT_SIZE each, arena scratch
+static FP32 *wtTime;
+
+static void wtBuild(void);
+static FP32 wtLevelSynth(INT8U level);
+
+/******************************************************************************
+ * WaveTableInit() - Builds the default timbre straight from its harmonics.
+ *  A sine harmonic k is -N/2 in the imaginary part of bin k. The FFT scratch
+ *  is borrowed from the DSP arena for the build only.
+ ******************************************************************************/
+void WaveTableInit(void){
+    INT16U k;
+
+    while(arm_rfft_fast_init_f32(&wtFft, WT_SIZE) != ARM_MATH_SUCCESS){}    //Error Trap
+    wtSpec = DspArenaAlloc(WT_SIZE*sizeof(FP32));
+    wtWork = DspArenaAlloc(WT_SIZE*sizeof(FP32));
+    wtTime = DspArenaAlloc(WT_SIZE*sizeof(FP32));
+
+    for(k = 0; k < WT_SIZE; k++){
+        wtSpec[k] = 0.0f;
+    }
+    for(k = 0; k < WT_DEFAULT_HARMS; k++){
+        wtSpec[2u*(k + 1u) + 1u] = -wtDefaultHarms[k]*(FP32)(WT_SIZE/2u);
+    }
+    wtBuild();
+
+    //The arena goes to the analyzer next, nothing may write through these again
+    wtSpec = (FP32 *)0;
+    wtWork = (FP32 *)0;
+    wtTime = (FP32 *)0;
+}
+
+/******************************************************************************
+ * WaveTableSample() - The level comes from the position of the top bit of
+ *  'inc', so it is one CLZ. The lookup is WaveSine()'s, WT_BITS of index,
+ *  with 15 bits of interpolation instead of 16.
+ ******************************************************************************/
+INT32S WaveTableSample(INT32U phase, INT32U inc){
+    INT32S level = (INT32S)(32u - __CLZ(inc)) - (INT32S)WT_LEVEL0_BITS;
+    const INT16S *tbl;
+    INT32U idx = phase >> (32u - WT_BITS);
+    INT32S frac = (INT32S)((phase >> (16u - WT_BITS)) & 0xFFFFu);
+    INT32S s0;
+
+    if(level < 0){
+        level = 0;
+    }else if(level >= (INT32S)WT_LEVELS){
+        level = WT_LEVELS - 1u;
+    }else{}
+    tbl = wtLevels[level];
+    s0 = tbl[idx];
+    //The step can be up to +-65535 on a saw or square edge, so only 15 bits of
+    //fraction keep the product inside INT32S
+    return s0 + (((tbl[idx + 1u] - s0)*(frac >> 1)) >> 15);
+}
+
+/******************************************************************************
+ * wtBuild() - Makes the levels from wtSpec. The first pass finds the peak
+ *  of every level, since Gibbs ringing can push a band limited level over
+ *  the full one. The second scales all levels by the same gain, so the
+ *  loudness doesn't jump between octaves.
+ ******************************************************************************/
+static void wtBuild(void){
+    INT8U level;
+    INT16U n;
+    FP32 peak = 0.0f;
+    FP32 lvl_peak;
+    FP32 gain;
+
+    wtSpec[0] = 0.0f;               //No DC
+    wtSpec[1] = 0.0f;               //No Nyquist bin
+    for(level = 0; level < WT_LEVELS; level++){
+        lvl_peak = wtLevelSynth(level);
+        if(lvl_peak > peak){
+            peak = lvl_peak;
+        }else{}
+    }
+    if(peak > 0.0f){
+        gain = 32767.0f/peak;
+    }else{
+        gain = 0.0f;
+    }
+    for(level = 0; level < WT_LEVELS; level++){
+        (void)wtLevelSynth(level);
+        for(n = 0; n < WT_SIZE; n++){
+            wtLevels[level][n] = (INT16S)(wtTime[n]*gain);
+        }
+        wtLevels[level][WT_SIZE] = wtLevels[level][0];
+    }
+}
+
+/******************************************************************************
+ * wtLevelSynth() - Inverse FFT of wtSpec with the bins above the level's
+ *  limit cleared, into wtTime. Returns the peak magnitude.
+ ******************************************************************************/
+static FP32 wtLevelSynth(INT8U level){
+    INT16U top = (INT16U)(((WT_SIZE/2u) >> level) + 1u);   //First bin cleared
+    INT16U n;
+    FP32 peak = 0.0f;
+
+    if(level == 0){
+        top = WT_SIZE/2u;
+    }else{}
+    for(n = 0; n < WT_SIZE; n++){
+        if(n < 2u*top){
+            wtWork[n] = wtSpec[n];
+        }else{
+            wtWork[n] = 0.0f;
+        }
+    }
+    wtWork[1] = 0.0f;
+    arm_rfft_fast_f32(&wtFft, wtWork, wtTime, 1);
+    for(n = 0; n < WT_SIZE; n++){
+        if(wtTime[n] > peak){
+            peak = wtTime[n];
+        }else if(-wtTime[n] > peak){
+            peak = -wtTime[n];
+        }else{}
+    }
+    return peak;
+}
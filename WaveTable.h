@@ -0,0 +1,29 @@
+/********************************************************************
+* WaveTable.h - Header file for the mipmapped wavetable oscillator
+* One cycle of an arbitrary waveform is kept as WT_LEVELS band
+* limited copies, one per octave. Each level holds half the
+* harmonics of the one below it, so the oscillator can always pick
+* a level with nothing above Nyquist.
+*
+* agent, 10/18/2026
+********************************************************************/
+#ifndef WAVETABLE_H_
+#define WAVETABLE_H_
+
+#define WT_BITS 9u                  //log2 of the samples in one cycle
+#define WT_SIZE (1u << WT_BITS)
+#define WT_LEVELS 8u                //Octaves, the top one keeps harmonics 1 and 2
+
+/******************************************************************************
+ * WaveTableInit() - Sets up the FFT and builds the default theremin-like
+ *  timbre. Call before WaveTask starts.
+ ******************************************************************************/
+void WaveTableInit(void);
+
+/******************************************************************************
+ * WaveTableSample() - Q15 sample at 'phase' (2^32 per cycle) from the level
+ *  that is band limited for the phase step 'inc'. Interpolates like the sine.
+ ******************************************************************************/
+INT32S WaveTableSample(INT32U phase, INT32U inc);
+
+#endif
@@ -0,0 +1,428 @@
+/********************************************************************
+* Window.c - Window function tables for the frequency analyzer
+* Periodic (DFT-even) windows w[n] = sum_k (-1)^k a_k cos(2*pi*k*n/N)
+* for the DSP_FFT_SIZE point analysis frame. Only n = 0..N/2 is
+* stored since w[N-n] = w[n]. Tables are const so they stay in flash.
+*
+* agent, 10/18/2026
+********************************************************************/
+#include "MCUType.h"
+#include "DspArena.h"
+#include "Window.h"
+
+#define WIN_TABLE_FFT_SIZE 1024     //FFT size the tables below were generated for
+
+#if WIN_TABLE_FFT_SIZE != DSP_FFT_SIZE
+#error "Window tables do not match DSP_FFT_SIZE, regenerate Window.c"
+#endif
+
+/* Hann, a = {0.5, 0.5} */
+static const FP32 WinHannTbl[WIN_HALF_SIZE] = {
+    0.000000000e+00f, 9.412358699e-06f, 3.764908043e-05f, 8.470910209e-05f,
+    1.505906519e-04f, 2.352912495e-04f, 3.388077058e-04f, 4.611361237e-04f,
+    6.022718974e-04f, 7.622097134e-04f, 9.409435499e-04f, 1.138466678e-03f,
+    1.354771661e-03f, 1.589850354e-03f, 1.843693909e-03f, 2.116292766e-03f,
+    2.407636664e-03f, 2.717714633e-03f, 3.046514999e-03f, 3.394025383e-03f,
+    3.760232701e-03f, 4.145123165e-03f, 4.548682286e-03f, 4.970894869e-03f,
+    5.411745018e-03f, 5.871216135e-03f, 6.349290921e-03f, 6.845951378e-03f,
+    7.361178806e-03f, 7.894953807e-03f, 8.447256284e-03f, 9.018065445e-03f,
+    9.607359798e-03f, 1.021511716e-02f, 1.084131464e-02f, 1.148592867e-02f,
+    1.214893498e-02f, 1.283030861e-02f, 1.353002390e-02f, 1.424805451e-02f,
+    1.498437340e-02f, 1.573895286e-02f, 1.651176448e-02f, 1.730277915e-02f,
+    1.811196710e-02f, 1.893929787e-02f, 1.978474029e-02f, 2.064826255e-02f,
+    2.152983213e-02f, 2.242941585e-02f, 2.334697982e-02f, 2.428248952e-02f,
+    2.523590970e-02f, 2.620720449e-02f, 2.719633731e-02f, 2.820327092e-02f,
+    2.922796741e-02f, 3.027038820e-02f, 3.133049404e-02f, 3.240824503e-02f,
+    3.350360058e-02f, 3.461651946e-02f, 3.574695976e-02f, 3.689487893e-02f,
+    3.806023374e-02f, 3.924298033e-02f, 4.044307415e-02f, 4.166047004e-02f,
+    4.289512215e-02f, 4.414698400e-02f, 4.541600845e-02f, 4.670214774e-02f,
+    4.800535344e-02f, 4.932557648e-02f, 5.066276715e-02f, 5.201687512e-02f,
+    5.338784940e-02f, 5.477563838e-02f, 5.618018980e-02f, 5.760145078e-02f,
+    5.903936783e-02f, 6.049388679e-02f, 6.196495290e-02f, 6.345251079e-02f,
+    6.495650445e-02f, 6.647687724e-02f, 6.801357194e-02f, 6.956653068e-02f,
+    7.113569500e-02f, 7.272100582e-02f, 7.432240345e-02f, 7.593982760e-02f,
+    7.757321738e-02f, 7.922251128e-02f, 8.088764722e-02f, 8.256856251e-02f,
+    8.426519385e-02f, 8.597747737e-02f, 8.770534861e-02f, 8.944874250e-02f,
+    9.120759342e-02f, 9.298183515e-02f, 9.477140087e-02f, 9.657622323e-02f,
+    9.839623426e-02f, 1.002313654e-01f, 1.020815477e-01f, 1.039467113e-01f,
+    1.058267862e-01f, 1.077217014e-01f, 1.096313857e-01f, 1.115557672e-01f,
+    1.134947733e-01f, 1.154483312e-01f, 1.174163672e-01f, 1.193988073e-01f,
+    1.213955767e-01f, 1.234066005e-01f, 1.254318027e-01f, 1.274711073e-01f,
+    1.295244373e-01f, 1.315917156e-01f, 1.336728642e-01f, 1.357678048e-01f,
+    1.378764585e-01f, 1.399987460e-01f, 1.421345874e-01f, 1.442839021e-01f,
+    1.464466094e-01f, 1.486226278e-01f, 1.508118753e-01f, 1.530142696e-01f,
+    1.552297276e-01f, 1.574581661e-01f, 1.596995011e-01f, 1.619536482e-01f,
+    1.642205226e-01f, 1.665000388e-01f, 1.687921112e-01f, 1.710966534e-01f,
+    1.734135785e-01f, 1.757427995e-01f, 1.780842286e-01f, 1.804377776e-01f,
+    1.828033579e-01f, 1.851808805e-01f, 1.875702559e-01f, 1.899713941e-01f,
+    1.923842047e-01f, 1.948085969e-01f, 1.972444793e-01f, 1.996917603e-01f,
+    2.021503478e-01f, 2.046201491e-01f, 2.071010713e-01f, 2.095930210e-01f,
+    2.120959043e-01f, 2.146096271e-01f, 2.171340946e-01f, 2.196692119e-01f,
+    2.222148835e-01f, 2.247710135e-01f, 2.273375058e-01f, 2.299142636e-01f,
+    2.325011901e-01f, 2.350981877e-01f, 2.377051587e-01f, 2.403220049e-01f,
+    2.429486279e-01f, 2.455849287e-01f, 2.482308081e-01f, 2.508861665e-01f,
+    2.535509039e-01f, 2.562249199e-01f, 2.589081140e-01f, 2.616003850e-01f,
+    2.643016316e-01f, 2.670117521e-01f, 2.697306445e-01f, 2.724582064e-01f,
+    2.751943352e-01f, 2.779389277e-01f, 2.806918807e-01f, 2.834530906e-01f,
+    2.862224533e-01f, 2.889998646e-01f, 2.917852200e-01f, 2.945784145e-01f,
+    2.973793430e-01f, 3.001879001e-01f, 3.030039800e-01f, 3.058274767e-01f,
+    3.086582838e-01f, 3.114962949e-01f, 3.143414030e-01f, 3.171935011e-01f,
+    3.200524817e-01f, 3.229182373e-01f, 3.257906599e-01f, 3.286696413e-01f,
+    3.315550733e-01f, 3.344468471e-01f, 3.373448539e-01f, 3.402489846e-01f,
+    3.431591298e-01f, 3.460751800e-01f, 3.489970253e-01f, 3.519245559e-01f,
+    3.548576614e-01f, 3.577962314e-01f, 3.607401553e-01f, 3.636893223e-01f,
+    3.666436213e-01f, 3.696029410e-01f, 3.725671702e-01f, 3.755361971e-01f,
+    3.785099100e-01f, 3.814881970e-01f, 3.844709459e-01f, 3.874580443e-01f,
+    3.904493799e-01f, 3.934448400e-01f, 3.964443119e-01f, 3.994476826e-01f,
+    4.024548390e-01f, 4.054656679e-01f, 4.084800560e-01f, 4.114978898e-01f,
+    4.145190556e-01f, 4.175434398e-01f, 4.205709283e-01f, 4.236014074e-01f,
+    4.266347628e-01f, 4.296708803e-01f, 4.327096457e-01f, 4.357509446e-01f,
+    4.387946624e-01f, 4.418406845e-01f, 4.448888964e-01f, 4.479391831e-01f,
+    4.509914298e-01f, 4.540455218e-01f, 4.571013438e-01f, 4.601587810e-01f,
+    4.632177182e-01f, 4.662780402e-01f, 4.693396318e-01f, 4.724023778e-01f,
+    4.754661628e-01f, 4.785308715e-01f, 4.815963885e-01f, 4.846625984e-01f,
+    4.877293857e-01f, 4.907966350e-01f, 4.938642309e-01f, 4.969320577e-01f,
+    5.000000000e-01f, 5.030679423e-01f, 5.061357691e-01f, 5.092033650e-01f,
+    5.122706143e-01f, 5.153374016e-01f, 5.184036115e-01f, 5.214691285e-01f,
+    5.245338372e-01f, 5.275976222e-01f, 5.306603682e-01f, 5.337219598e-01f,
+    5.367822818e-01f, 5.398412190e-01f, 5.428986562e-01f, 5.459544782e-01f,
+    5.490085702e-01f, 5.520608169e-01f, 5.551111036e-01f, 5.581593155e-01f,
+    5.612053376e-01f, 5.642490554e-01f, 5.672903543e-01f, 5.703291197e-01f,
+    5.733652372e-01f, 5.763985926e-01f, 5.794290717e-01f, 5.824565602e-01f,
+    5.854809444e-01f, 5.885021102e-01f, 5.915199440e-01f, 5.945343321e-01f,
+    5.975451610e-01f, 6.005523174e-01f, 6.035556881e-01f, 6.065551600e-01f,
+    6.095506201e-01f, 6.125419557e-01f, 6.155290541e-01f, 6.185118030e-01f,
+    6.214900900e-01f, 6.244638029e-01f, 6.274328298e-01f, 6.303970590e-01f,
+    6.333563787e-01f, 6.363106777e-01f, 6.392598447e-01f, 6.422037686e-01f,
+    6.451423386e-01f, 6.480754441e-01f, 6.510029747e-01f, 6.539248200e-01f,
+    6.568408702e-01f, 6.597510154e-01f, 6.626551461e-01f, 6.655531529e-01f,
+    6.684449267e-01f, 6.713303587e-01f, 6.742093401e-01f, 6.770817627e-01f,
+    6.799475183e-01f, 6.828064989e-01f, 6.856585970e-01f, 6.885037051e-01f,
+    6.913417162e-01f, 6.941725233e-01f, 6.969960200e-01f, 6.998120999e-01f,
+    7.026206570e-01f, 7.054215855e-01f, 7.082147800e-01f, 7.110001354e-01f,
+    7.137775467e-01f, 7.165469094e-01f, 7.193081193e-01f, 7.220610723e-01f,
+    7.248056648e-01f, 7.275417936e-01f, 7.302693555e-01f, 7.329882479e-01f,
+    7.356983684e-01f, 7.383996150e-01f, 7.410918860e-01f, 7.437750801e-01f,
+    7.464490961e-01f, 7.491138335e-01f, 7.517691919e-01f, 7.544150713e-01f,
+    7.570513721e-01f, 7.596779951e-01f, 7.622948413e-01f, 7.649018123e-01f,
+    7.674988099e-01f, 7.700857364e-01f, 7.726624942e-01f, 7.752289865e-01f,
+    7.777851165e-01f, 7.803307881e-01f, 7.828659054e-01f, 7.853903729e-01f,
+    7.879040957e-01f, 7.904069790e-01f, 7.928989287e-01f, 7.953798509e-01f,
+    7.978496522e-01f, 8.003082397e-01f, 8.027555207e-01f, 8.051914031e-01f,
+    8.076157953e-01f, 8.100286059e-01f, 8.124297441e-01f, 8.148191195e-01f,
+    8.171966421e-01f, 8.195622224e-01f, 8.219157714e-01f, 8.242572005e-01f,
+    8.265864215e-01f, 8.289033466e-01f, 8.312078888e-01f, 8.334999612e-01f,
+    8.357794774e-01f, 8.380463518e-01f, 8.403004989e-01f, 8.425418339e-01f,
+    8.447702724e-01f, 8.469857304e-01f, 8.491881247e-01f, 8.513773722e-01f,
+    8.535533906e-01f, 8.557160979e-01f, 8.578654126e-01f, 8.600012540e-01f,
+    8.621235415e-01f, 8.642321952e-01f, 8.663271358e-01f, 8.684082844e-01f,
+    8.704755627e-01f, 8.725288927e-01f, 8.745681973e-01f, 8.765933995e-01f,
+    8.786044233e-01f, 8.806011927e-01f, 8.825836328e-01f, 8.845516688e-01f,
+    8.865052267e-01f, 8.884442328e-01f, 8.903686143e-01f, 8.922782986e-01f,
+    8.941732138e-01f, 8.960532887e-01f, 8.979184523e-01f, 8.997686346e-01f,
+    9.016037657e-01f, 9.034237768e-01f, 9.052285991e-01f, 9.070181649e-01f,
+    9.087924066e-01f, 9.105512575e-01f, 9.122946514e-01f, 9.140225226e-01f,
+    9.157348062e-01f, 9.174314375e-01f, 9.191123528e-01f, 9.207774887e-01f,
+    9.224267826e-01f, 9.240601724e-01f, 9.256775966e-01f, 9.272789942e-01f,
+    9.288643050e-01f, 9.304334693e-01f, 9.319864281e-01f, 9.335231228e-01f,
+    9.350434956e-01f, 9.365474892e-01f, 9.380350471e-01f, 9.395061132e-01f,
+    9.409606322e-01f, 9.423985492e-01f, 9.438198102e-01f, 9.452243616e-01f,
+    9.466121506e-01f, 9.479831249e-01f, 9.493372328e-01f, 9.506744235e-01f,
+    9.519946466e-01f, 9.532978523e-01f, 9.545839915e-01f, 9.558530160e-01f,
+    9.571048779e-01f, 9.583395300e-01f, 9.595569258e-01f, 9.607570197e-01f,
+    9.619397663e-01f, 9.631051211e-01f, 9.642530402e-01f, 9.653834805e-01f,
+    9.664963994e-01f, 9.675917550e-01f, 9.686695060e-01f, 9.697296118e-01f,
+    9.707720326e-01f, 9.717967291e-01f, 9.728036627e-01f, 9.737927955e-01f,
+    9.747640903e-01f, 9.757175105e-01f, 9.766530202e-01f, 9.775705842e-01f,
+    9.784701679e-01f, 9.793517374e-01f, 9.802152597e-01f, 9.810607021e-01f,
+    9.818880329e-01f, 9.826972208e-01f, 9.834882355e-01f, 9.842610471e-01f,
+    9.850156266e-01f, 9.857519455e-01f, 9.864699761e-01f, 9.871696914e-01f,
+    9.878510650e-01f, 9.885140713e-01f, 9.891586854e-01f, 9.897848828e-01f,
+    9.903926402e-01f, 9.909819346e-01f, 9.915527437e-01f, 9.921050462e-01f,
+    9.926388212e-01f, 9.931540486e-01f, 9.936507091e-01f, 9.941287839e-01f,
+    9.945882550e-01f, 9.950291051e-01f, 9.954513177e-01f, 9.958548768e-01f,
+    9.962397673e-01f, 9.966059746e-01f, 9.969534850e-01f, 9.972822854e-01f,
+    9.975923633e-01f, 9.978837072e-01f, 9.981563061e-01f, 9.984101496e-01f,
+    9.986452283e-01f, 9.988615333e-01f, 9.990590565e-01f, 9.992377903e-01f,
+    9.993977281e-01f, 9.995388639e-01f, 9.996611923e-01f, 9.997647088e-01f,
+    9.998494093e-01f, 9.999152909e-01f, 9.999623509e-01f, 9.999905876e-01f,
+    1.000000000e+00f
+};
+
+/* 4-term Blackman-Harris, a = {0.35875, 0.48829, 0.14128, 0.01168} */
+static const FP32 WinBlackmanHarrisTbl[WIN_HALF_SIZE] = {
+    6.000000000e-05f, 6.053260172e-05f, 6.213099237e-05f, 6.479692846e-05f,
+    6.853333749e-05f, 7.334431794e-05f, 7.923513929e-05f, 8.621224199e-05f,
+    9.428323744e-05f, 1.034569080e-04f, 1.137432069e-04f, 1.251532583e-04f,
+    1.376993573e-04f, 1.513949697e-04f, 1.662547322e-04f, 1.822944520e-04f,
+    1.995311072e-04f, 2.179828465e-04f, 2.376689889e-04f, 2.586100241e-04f,
+    2.808276117e-04f, 3.043445820e-04f, 3.291849348e-04f, 3.553738402e-04f,
+    3.829376379e-04f, 4.119038368e-04f, 4.423011156e-04f, 4.741593215e-04f,
+    5.075094708e-04f, 5.423837481e-04f, 5.788155061e-04f, 6.168392653e-04f,
+    6.564907134e-04f, 6.978067051e-04f, 7.408252615e-04f, 7.855855695e-04f,
+    8.321279813e-04f, 8.804940138e-04f, 9.307263480e-04f, 9.828688280e-04f,
+    1.036966461e-03f, 1.093065414e-03f, 1.151213018e-03f, 1.211457761e-03f,
+    1.273849291e-03f, 1.338438414e-03f, 1.405277091e-03f, 1.474418440e-03f,
+    1.545916732e-03f, 1.619827392e-03f, 1.696206994e-03f, 1.775113262e-03f,
+    1.856605070e-03f, 1.940742435e-03f, 2.027586520e-03f, 2.117199630e-03f,
+    2.209645211e-03f, 2.304987844e-03f, 2.403293250e-03f, 2.504628280e-03f,
+    2.609060917e-03f, 2.716660272e-03f, 2.827496583e-03f, 2.941641208e-03f,
+    3.059166626e-03f, 3.180146432e-03f, 3.304655333e-03f, 3.432769148e-03f,
+    3.564564800e-03f, 3.700120315e-03f, 3.839514817e-03f, 3.982828525e-03f,
+    4.130142746e-03f, 4.281539876e-03f, 4.437103390e-03f, 4.596917839e-03f,
+    4.761068847e-03f, 4.929643104e-03f, 5.102728362e-03f, 5.280413426e-03f,
+    5.462788153e-03f, 5.649943446e-03f, 5.841971243e-03f, 6.038964516e-03f,
+    6.241017262e-03f, 6.448224497e-03f, 6.660682250e-03f, 6.878487553e-03f,
+    7.101738438e-03f, 7.330533926e-03f, 7.564974020e-03f, 7.805159700e-03f,
+    8.051192910e-03f, 8.303176553e-03f, 8.561214481e-03f, 8.825411487e-03f,
+    9.095873294e-03f, 9.372706549e-03f, 9.656018809e-03f, 9.945918536e-03f,
+    1.024251508e-02f, 1.054591868e-02f, 1.085624044e-02f, 1.117359232e-02f,
+    1.149808714e-02f, 1.182983856e-02f, 1.216896105e-02f, 1.251556990e-02f,
+    1.286978122e-02f, 1.323171188e-02f, 1.360147954e-02f, 1.397920262e-02f,
+    1.436500031e-02f, 1.475899250e-02f, 1.516129984e-02f, 1.557204365e-02f,
+    1.599134597e-02f, 1.641932952e-02f, 1.685611766e-02f, 1.730183442e-02f,
+    1.775660446e-02f, 1.822055305e-02f, 1.869380605e-02f, 1.917648993e-02f,
+    1.966873170e-02f, 2.017065894e-02f, 2.068239974e-02f, 2.120408273e-02f,
+    2.173583702e-02f, 2.227779219e-02f, 2.283007830e-02f, 2.339282584e-02f,
+    2.396616571e-02f, 2.455022922e-02f, 2.514514807e-02f, 2.575105431e-02f,
+    2.636808032e-02f, 2.699635882e-02f, 2.763602282e-02f, 2.828720561e-02f,
+    2.895004073e-02f, 2.962466194e-02f, 3.031120324e-02f, 3.100979880e-02f,
+    3.172058295e-02f, 3.244369018e-02f, 3.317925508e-02f, 3.392741236e-02f,
+    3.468829677e-02f, 3.546204311e-02f, 3.624878624e-02f, 3.704866096e-02f,
+    3.786180209e-02f, 3.868834436e-02f, 3.952842245e-02f, 4.038217091e-02f,
+    4.124972417e-02f, 4.213121651e-02f, 4.302678199e-02f, 4.393655450e-02f,
+    4.486066767e-02f, 4.579925485e-02f, 4.675244912e-02f, 4.772038323e-02f,
+    4.870318955e-02f, 4.970100011e-02f, 5.071394650e-02f, 5.174215990e-02f,
+    5.278577099e-02f, 5.384490997e-02f, 5.491970653e-02f, 5.601028977e-02f,
+    5.711678822e-02f, 5.823932979e-02f, 5.937804175e-02f, 6.053305068e-02f,
+    6.170448246e-02f, 6.289246222e-02f, 6.409711432e-02f, 6.531856233e-02f,
+    6.655692897e-02f, 6.781233609e-02f, 6.908490466e-02f, 7.037475470e-02f,
+    7.168200528e-02f, 7.300677447e-02f, 7.434917931e-02f, 7.570933579e-02f,
+    7.708735879e-02f, 7.848336208e-02f, 7.989745826e-02f, 8.132975874e-02f,
+    8.278037370e-02f, 8.424941209e-02f, 8.573698153e-02f, 8.724318833e-02f,
+    8.876813746e-02f, 9.031193246e-02f, 9.187467549e-02f, 9.345646720e-02f,
+    9.505740680e-02f, 9.667759194e-02f, 9.831711871e-02f, 9.997608162e-02f,
+    1.016545736e-01f, 1.033526857e-01f, 1.050705077e-01f, 1.068081271e-01f,
+    1.085656302e-01f, 1.103431011e-01f, 1.121406223e-01f, 1.139582742e-01f,
+    1.157961356e-01f, 1.176542831e-01f, 1.195327916e-01f, 1.214317337e-01f,
+    1.233511803e-01f, 1.252912000e-01f, 1.272518595e-01f, 1.292332230e-01f,
+    1.312353531e-01f, 1.332583097e-01f, 1.353021508e-01f, 1.373669320e-01f,
+    1.394527066e-01f, 1.415595257e-01f, 1.436874380e-01f, 1.458364897e-01f,
+    1.480067247e-01f, 1.501981845e-01f, 1.524109080e-01f, 1.546449317e-01f,
+    1.569002895e-01f, 1.591770128e-01f, 1.614751303e-01f, 1.637946682e-01f,
+    1.661356500e-01f, 1.684980964e-01f, 1.708820257e-01f, 1.732874531e-01f,
+    1.757143912e-01f, 1.781628498e-01f, 1.806328359e-01f, 1.831243537e-01f,
+    1.856374044e-01f, 1.881719863e-01f, 1.907280949e-01f, 1.933057227e-01f,
+    1.959048591e-01f, 1.985254906e-01f, 2.011676008e-01f, 2.038311700e-01f,
+    2.065161756e-01f, 2.092225918e-01f, 2.119503898e-01f, 2.146995376e-01f,
+    2.174700000e-01f, 2.202617386e-01f, 2.230747120e-01f, 2.259088752e-01f,
+    2.287641803e-01f, 2.316405760e-01f, 2.345380078e-01f, 2.374564177e-01f,
+    2.403957446e-01f, 2.433559239e-01f, 2.463368878e-01f, 2.493385650e-01f,
+    2.523608809e-01f, 2.554037576e-01f, 2.584671134e-01f, 2.615508637e-01f,
+    2.646549200e-01f, 2.677791907e-01f, 2.709235805e-01f, 2.740879907e-01f,
+    2.772723191e-01f, 2.804764601e-01f, 2.837003046e-01f, 2.869437397e-01f,
+    2.902066492e-01f, 2.934889136e-01f, 2.967904093e-01f, 3.001110097e-01f,
+    3.034505842e-01f, 3.068089991e-01f, 3.101861168e-01f, 3.135817962e-01f,
+    3.169958927e-01f, 3.204282581e-01f, 3.238787406e-01f, 3.273471850e-01f,
+    3.308334322e-01f, 3.343373199e-01f, 3.378586820e-01f, 3.413973488e-01f,
+    3.449531472e-01f, 3.485259005e-01f, 3.521154282e-01f, 3.557215467e-01f,
+    3.593440684e-01f, 3.629828024e-01f, 3.666375543e-01f, 3.703081261e-01f,
+    3.739943161e-01f, 3.776959195e-01f, 3.814127275e-01f, 3.851445283e-01f,
+    3.888911064e-01f, 3.926522426e-01f, 3.964277147e-01f, 4.002172968e-01f,
+    4.040207595e-01f, 4.078378702e-01f, 4.116683928e-01f, 4.155120879e-01f,
+    4.193687126e-01f, 4.232380207e-01f, 4.271197627e-01f, 4.310136859e-01f,
+    4.349195342e-01f, 4.388370482e-01f, 4.427659654e-01f, 4.467060200e-01f,
+    4.506569429e-01f, 4.546184621e-01f, 4.585903022e-01f, 4.625721848e-01f,
+    4.665638283e-01f, 4.705649483e-01f, 4.745752571e-01f, 4.785944641e-01f,
+    4.826222756e-01f, 4.866583951e-01f, 4.907025231e-01f, 4.947543573e-01f,
+    4.988135925e-01f, 5.028799206e-01f, 5.069530308e-01f, 5.110326095e-01f,
+    5.151183404e-01f, 5.192099045e-01f, 5.233069803e-01f, 5.274092434e-01f,
+    5.315163671e-01f, 5.356280219e-01f, 5.397438762e-01f, 5.438635955e-01f,
+    5.479868433e-01f, 5.521132803e-01f, 5.562425652e-01f, 5.603743543e-01f,
+    5.645083017e-01f, 5.686440592e-01f, 5.727812765e-01f, 5.769196012e-01f,
+    5.810586789e-01f, 5.851981529e-01f, 5.893376650e-01f, 5.934768546e-01f,
+    5.976153595e-01f, 6.017528156e-01f, 6.058888570e-01f, 6.100231161e-01f,
+    6.141552236e-01f, 6.182848086e-01f, 6.224114985e-01f, 6.265349194e-01f,
+    6.306546957e-01f, 6.347704505e-01f, 6.388818055e-01f, 6.429883811e-01f,
+    6.470897964e-01f, 6.511856694e-01f, 6.552756168e-01f, 6.593592543e-01f,
+    6.634361965e-01f, 6.675060571e-01f, 6.715684488e-01f, 6.756229835e-01f,
+    6.796692722e-01f, 6.837069252e-01f, 6.877355522e-01f, 6.917547619e-01f,
+    6.957641630e-01f, 6.997633631e-01f, 7.037519698e-01f, 7.077295900e-01f,
+    7.116958304e-01f, 7.156502973e-01f, 7.195925970e-01f, 7.235223355e-01f,
+    7.274391187e-01f, 7.313425525e-01f, 7.352322427e-01f, 7.391077955e-01f,
+    7.429688169e-01f, 7.468149133e-01f, 7.506456915e-01f, 7.544607582e-01f,
+    7.582597211e-01f, 7.620421878e-01f, 7.658077669e-01f, 7.695560672e-01f,
+    7.732866984e-01f, 7.769992709e-01f, 7.806933957e-01f, 7.843686849e-01f,
+    7.880247513e-01f, 7.916612087e-01f, 7.952776721e-01f, 7.988737575e-01f,
+    8.024490819e-01f, 8.060032638e-01f, 8.095359227e-01f, 8.130466798e-01f,
+    8.165351574e-01f, 8.200009794e-01f, 8.234437712e-01f, 8.268631599e-01f,
+    8.302587743e-01f, 8.336302447e-01f, 8.369772033e-01f, 8.402992842e-01f,
+    8.435961235e-01f, 8.468673591e-01f, 8.501126309e-01f, 8.533315812e-01f,
+    8.565238541e-01f, 8.596890962e-01f, 8.628269562e-01f, 8.659370853e-01f,
+    8.690191369e-01f, 8.720727670e-01f, 8.750976342e-01f, 8.780933995e-01f,
+    8.810597266e-01f, 8.839962820e-01f, 8.869027348e-01f, 8.897787571e-01f,
+    8.926240236e-01f, 8.954382122e-01f, 8.982210037e-01f, 9.009720818e-01f,
+    9.036911335e-01f, 9.063778488e-01f, 9.090319210e-01f, 9.116530466e-01f,
+    9.142409255e-01f, 9.167952608e-01f, 9.193157592e-01f, 9.218021307e-01f,
+    9.242540891e-01f, 9.266713514e-01f, 9.290536384e-01f, 9.314006747e-01f,
+    9.337121885e-01f, 9.359879117e-01f, 9.382275801e-01f, 9.404309333e-01f,
+    9.425977150e-01f, 9.447276727e-01f, 9.468205578e-01f, 9.488761260e-01f,
+    9.508941369e-01f, 9.528743544e-01f, 9.548165463e-01f, 9.567204850e-01f,
+    9.585859468e-01f, 9.604127125e-01f, 9.622005672e-01f, 9.639493004e-01f,
+    9.656587060e-01f, 9.673285823e-01f, 9.689587322e-01f, 9.705489630e-01f,
+    9.720990867e-01f, 9.736089197e-01f, 9.750782833e-01f, 9.765070032e-01f,
+    9.778949100e-01f, 9.792418388e-01f, 9.805476297e-01f, 9.818121275e-01f,
+    9.830351816e-01f, 9.842166465e-01f, 9.853563816e-01f, 9.864542509e-01f,
+    9.875101236e-01f, 9.885238737e-01f, 9.894953802e-01f, 9.904245271e-01f,
+    9.913112033e-01f, 9.921553029e-01f, 9.929567249e-01f, 9.937153734e-01f,
+    9.944311577e-01f, 9.951039921e-01f, 9.957337959e-01f, 9.963204937e-01f,
+    9.968640153e-01f, 9.973642954e-01f, 9.978212741e-01f, 9.982348965e-01f,
+    9.986051131e-01f, 9.989318795e-01f, 9.992151563e-01f, 9.994549097e-01f,
+    9.996511108e-01f, 9.998037361e-01f, 9.999127672e-01f, 9.999781911e-01f,
+    1.000000000e+00f
+};
+
+/* 5-term flat-top, a = {0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368} */
+static const FP32 WinFlatTopTbl[WIN_HALF_SIZE] = {
+    -4.210510000e-04f, -4.220180564e-04f, -4.249199141e-04f, -4.297586390e-04f,
+    -4.365376722e-04f, -4.452618291e-04f, -4.559372955e-04f, -4.685716248e-04f,
+    -4.831737331e-04f, -4.997538941e-04f, -5.183237330e-04f, -5.388962195e-04f,
+    -5.614856606e-04f, -5.861076915e-04f, -6.127792667e-04f, -6.415186500e-04f,
+    -6.723454031e-04f, -7.052803745e-04f, -7.403456867e-04f, -7.775647229e-04f,
+    -8.169621128e-04f, -8.585637183e-04f, -9.023966167e-04f, -9.484890855e-04f,
+    -9.968705839e-04f, -1.047571736e-03f, -1.100624309e-03f, -1.156061200e-03f,
+    -1.213916406e-03f, -1.274225013e-03f, -1.337023164e-03f, -1.402348044e-03f,
+    -1.470237854e-03f, -1.540731783e-03f, -1.613869989e-03f, -1.689693567e-03f,
+    -1.768244528e-03f, -1.849565766e-03f, -1.933701035e-03f, -2.020694914e-03f,
+    -2.110592784e-03f, -2.203440793e-03f, -2.299285824e-03f, -2.398175466e-03f,
+    -2.500157981e-03f, -2.605282267e-03f, -2.713597828e-03f, -2.825154736e-03f,
+    -2.940003596e-03f, -3.058195510e-03f, -3.179782040e-03f, -3.304815168e-03f,
+    -3.433347262e-03f, -3.565431032e-03f, -3.701119490e-03f, -3.840465913e-03f,
+    -3.983523800e-03f, -4.130346827e-03f, -4.280988809e-03f, -4.435503653e-03f,
+    -4.593945315e-03f, -4.756367757e-03f, -4.922824898e-03f, -5.093370571e-03f,
+    -5.268058476e-03f, -5.446942132e-03f, -5.630074828e-03f, -5.817509577e-03f,
+    -6.009299066e-03f, -6.205495607e-03f, -6.406151084e-03f, -6.611316906e-03f,
+    -6.821043954e-03f, -7.035382530e-03f, -7.254382302e-03f, -7.478092256e-03f,
+    -7.706560637e-03f, -7.939834900e-03f, -8.177961655e-03f, -8.420986608e-03f,
+    -8.668954512e-03f, -8.921909107e-03f, -9.179893067e-03f, -9.442947940e-03f,
+    -9.711114094e-03f, -9.984430662e-03f, -1.026293548e-02f, -1.054666503e-02f,
+    -1.083565438e-02f, -1.112993714e-02f, -1.142954538e-02f, -1.173450958e-02f,
+    -1.204485860e-02f, -1.236061957e-02f, -1.268181785e-02f, -1.300847699e-02f,
+    -1.334061866e-02f, -1.367826258e-02f, -1.402142644e-02f, -1.437012591e-02f,
+    -1.472437450e-02f, -1.508418355e-02f, -1.544956215e-02f, -1.582051708e-02f,
+    -1.619705275e-02f, -1.657917116e-02f, -1.696687180e-02f, -1.736015162e-02f,
+    -1.775900498e-02f, -1.816342355e-02f, -1.857339627e-02f, -1.898890931e-02f,
+    -1.940994598e-02f, -1.983648669e-02f, -2.026850889e-02f, -2.070598699e-02f,
+    -2.114889234e-02f, -2.159719313e-02f, -2.205085436e-02f, -2.250983780e-02f,
+    -2.297410187e-02f, -2.344360164e-02f, -2.391828877e-02f, -2.439811142e-02f,
+    -2.488301424e-02f, -2.537293828e-02f, -2.586782094e-02f, -2.636759595e-02f,
+    -2.687219329e-02f, -2.738153912e-02f, -2.789555580e-02f, -2.841416174e-02f,
+    -2.893727144e-02f, -2.946479540e-02f, -2.999664007e-02f, -3.053270781e-02f,
+    -3.107289686e-02f, -3.161710126e-02f, -3.216521087e-02f, -3.271711123e-02f,
+    -3.327268361e-02f, -3.383180492e-02f, -3.439434770e-02f, -3.496018004e-02f,
+    -3.552916559e-02f, -3.610116348e-02f, -3.667602834e-02f, -3.725361020e-02f,
+    -3.783375451e-02f, -3.841630210e-02f, -3.900108911e-02f, -3.958794704e-02f,
+    -4.017670263e-02f, -4.076717791e-02f, -4.135919014e-02f, -4.195255181e-02f,
+    -4.254707058e-02f, -4.314254931e-02f, -4.373878600e-02f, -4.433557381e-02f,
+    -4.493270101e-02f, -4.552995101e-02f, -4.612710230e-02f, -4.672392850e-02f,
+    -4.732019827e-02f, -4.791567541e-02f, -4.851011876e-02f, -4.910328224e-02f,
+    -4.969491488e-02f, -5.028476076e-02f, -5.087255905e-02f, -5.145804401e-02f,
+    -5.204094502e-02f, -5.262098653e-02f, -5.319788814e-02f, -5.377136456e-02f,
+    -5.434112567e-02f, -5.490687651e-02f, -5.546831729e-02f, -5.602514345e-02f,
+    -5.657704567e-02f, -5.712370985e-02f, -5.766481723e-02f, -5.820004434e-02f,
+    -5.872906306e-02f, -5.925154066e-02f, -5.976713986e-02f, -6.027551882e-02f,
+    -6.077633120e-02f, -6.126922624e-02f, -6.175384875e-02f, -6.222983921e-02f,
+    -6.269683378e-02f, -6.315446438e-02f, -6.360235873e-02f, -6.404014042e-02f,
+    -6.446742897e-02f, -6.488383989e-02f, -6.528898473e-02f, -6.568247117e-02f,
+    -6.606390308e-02f, -6.643288059e-02f, -6.678900017e-02f, -6.713185471e-02f,
+    -6.746103358e-02f, -6.777612274e-02f, -6.807670480e-02f, -6.836235912e-02f,
+    -6.863266188e-02f, -6.888718620e-02f, -6.912550221e-02f, -6.934717716e-02f,
+    -6.955177550e-02f, -6.973885901e-02f, -6.990798685e-02f, -7.005871573e-02f,
+    -7.019059997e-02f, -7.030319162e-02f, -7.039604059e-02f, -7.046869473e-02f,
+    -7.052069997e-02f, -7.055160044e-02f, -7.056093857e-02f, -7.054825522e-02f,
+    -7.051308982e-02f, -7.045498047e-02f, -7.037346409e-02f, -7.026807655e-02f,
+    -7.013835277e-02f, -6.998382689e-02f, -6.980403240e-02f, -6.959850225e-02f,
+    -6.936676904e-02f, -6.910836510e-02f, -6.882282270e-02f, -6.850967412e-02f,
+    -6.816845188e-02f, -6.779868881e-02f, -6.739991826e-02f, -6.697167421e-02f,
+    -6.651349145e-02f, -6.602490572e-02f, -6.550545387e-02f, -6.495467403e-02f,
+    -6.437210573e-02f, -6.375729012e-02f, -6.310977008e-02f, -6.242909041e-02f,
+    -6.171479797e-02f, -6.096644188e-02f, -6.018357366e-02f, -5.936574739e-02f,
+    -5.851251991e-02f, -5.762345097e-02f, -5.669810338e-02f, -5.573604322e-02f,
+    -5.473684000e-02f, -5.370006680e-02f, -5.262530048e-02f, -5.151212184e-02f,
+    -5.036011581e-02f, -4.916887157e-02f, -4.793798280e-02f, -4.666704781e-02f,
+    -4.535566970e-02f, -4.400345660e-02f, -4.261002177e-02f, -4.117498382e-02f,
+    -3.969796688e-02f, -3.817860077e-02f, -3.661652118e-02f, -3.501136983e-02f,
+    -3.336279468e-02f, -3.167045005e-02f, -2.993399685e-02f, -2.815310272e-02f,
+    -2.632744222e-02f, -2.445669698e-02f, -2.254055592e-02f, -2.057871535e-02f,
+    -1.857087921e-02f, -1.651675919e-02f, -1.441607492e-02f, -1.226855415e-02f,
+    -1.007393287e-02f, -7.831955549e-03f, -5.542375222e-03f, -3.204953703e-03f,
+    -8.194617275e-04f, 1.614320885e-03f, 4.096605070e-03f, 6.627592367e-03f,
+    9.207474757e-03f, 1.183643452e-02f, 1.451464406e-02f, 1.724226579e-02f,
+    2.001945197e-02f, 2.284634453e-02f, 2.572307498e-02f, 2.864976423e-02f,
+    3.162652248e-02f, 3.465344905e-02f, 3.773063226e-02f, 4.085814932e-02f,
+    4.403606617e-02f, 4.726443735e-02f, 5.054330592e-02f, 5.387270329e-02f,
+    5.725264912e-02f, 6.068315121e-02f, 6.416420538e-02f, 6.769579535e-02f,
+    7.127789266e-02f, 7.491045655e-02f, 7.859343384e-02f, 8.232675887e-02f,
+    8.611035338e-02f, 8.994412644e-02f, 9.382797432e-02f, 9.776178047e-02f,
+    1.017454154e-01f, 1.057787366e-01f, 1.098615884e-01f, 1.139938021e-01f,
+    1.181751957e-01f, 1.224055740e-01f, 1.266847283e-01f, 1.310124368e-01f,
+    1.353884638e-01f, 1.398125605e-01f, 1.442844644e-01f, 1.488038994e-01f,
+    1.533705759e-01f, 1.579841907e-01f, 1.626444266e-01f, 1.673509531e-01f,
+    1.721034258e-01f, 1.769014866e-01f, 1.817447638e-01f, 1.866328717e-01f,
+    1.915654110e-01f, 1.965419689e-01f, 2.015621184e-01f, 2.066254193e-01f,
+    2.117314173e-01f, 2.168796447e-01f, 2.220696199e-01f, 2.273008480e-01f,
+    2.325728202e-01f, 2.378850144e-01f, 2.432368950e-01f, 2.486279127e-01f,
+    2.540575050e-01f, 2.595250962e-01f, 2.650300970e-01f, 2.705719051e-01f,
+    2.761499051e-01f, 2.817634685e-01f, 2.874119536e-01f, 2.930947063e-01f,
+    2.988110592e-01f, 3.045603325e-01f, 3.103418337e-01f, 3.161548578e-01f,
+    3.219986873e-01f, 3.278725928e-01f, 3.337758322e-01f, 3.397076518e-01f,
+    3.456672858e-01f, 3.516539567e-01f, 3.576668751e-01f, 3.637052405e-01f,
+    3.697682408e-01f, 3.758550527e-01f, 3.819648419e-01f, 3.880967632e-01f,
+    3.942499606e-01f, 4.004235675e-01f, 4.066167072e-01f, 4.128284923e-01f,
+    4.190580257e-01f, 4.253044004e-01f, 4.315666996e-01f, 4.378439970e-01f,
+    4.441353573e-01f, 4.504398357e-01f, 4.567564788e-01f, 4.630843244e-01f,
+    4.694224019e-01f, 4.757697323e-01f, 4.821253287e-01f, 4.884881965e-01f,
+    4.948573331e-01f, 5.012317288e-01f, 5.076103669e-01f, 5.139922236e-01f,
+    5.203762684e-01f, 5.267614646e-01f, 5.331467690e-01f, 5.395311328e-01f,
+    5.459135013e-01f, 5.522928145e-01f, 5.586680072e-01f, 5.650380093e-01f,
+    5.714017459e-01f, 5.777581379e-01f, 5.841061020e-01f, 5.904445512e-01f,
+    5.967723947e-01f, 6.030885384e-01f, 6.093918854e-01f, 6.156813359e-01f,
+    6.219557876e-01f, 6.282141361e-01f, 6.344552749e-01f, 6.406780962e-01f,
+    6.468814906e-01f, 6.530643477e-01f, 6.592255564e-01f, 6.653640052e-01f,
+    6.714785822e-01f, 6.775681759e-01f, 6.836316751e-01f, 6.896679691e-01f,
+    6.956759485e-01f, 7.016545051e-01f, 7.076025323e-01f, 7.135189253e-01f,
+    7.194025817e-01f, 7.252524014e-01f, 7.310672871e-01f, 7.368461449e-01f,
+    7.425878838e-01f, 7.482914170e-01f, 7.539556612e-01f, 7.595795377e-01f,
+    7.651619724e-01f, 7.707018960e-01f, 7.761982443e-01f, 7.816499586e-01f,
+    7.870559862e-01f, 7.924152802e-01f, 7.977268002e-01f, 8.029895124e-01f,
+    8.082023900e-01f, 8.133644134e-01f, 8.184745705e-01f, 8.235318570e-01f,
+    8.285352769e-01f, 8.334838423e-01f, 8.383765741e-01f, 8.432125021e-01f,
+    8.479906655e-01f, 8.527101127e-01f, 8.573699021e-01f, 8.619691021e-01f,
+    8.665067913e-01f, 8.709820589e-01f, 8.753940052e-01f, 8.797417412e-01f,
+    8.840243896e-01f, 8.882410846e-01f, 8.923909721e-01f, 8.964732103e-01f,
+    9.004869698e-01f, 9.044314338e-01f, 9.083057981e-01f, 9.121092718e-01f,
+    9.158410774e-01f, 9.195004508e-01f, 9.230866415e-01f, 9.265989134e-01f,
+    9.300365442e-01f, 9.333988264e-01f, 9.366850667e-01f, 9.398945870e-01f,
+    9.430267242e-01f, 9.460808301e-01f, 9.490562723e-01f, 9.519524338e-01f,
+    9.547687135e-01f, 9.575045262e-01f, 9.601593030e-01f, 9.627324912e-01f,
+    9.652235544e-01f, 9.676319732e-01f, 9.699572448e-01f, 9.721988835e-01f,
+    9.743564203e-01f, 9.764294040e-01f, 9.784174004e-01f, 9.803199929e-01f,
+    9.821367825e-01f, 9.838673880e-01f, 9.855114459e-01f, 9.870686110e-01f,
+    9.885385559e-01f, 9.899209715e-01f, 9.912155668e-01f, 9.924220693e-01f,
+    9.935402249e-01f, 9.945697982e-01f, 9.955105719e-01f, 9.963623479e-01f,
+    9.971249465e-01f, 9.977982068e-01f, 9.983819867e-01f, 9.988761630e-01f,
+    9.992806315e-01f, 9.995953067e-01f, 9.998201221e-01f, 9.999550304e-01f,
+    1.000000003e+00f
+};
+
+/*********************************************************************
+* Private Resources
+********************************************************************/
+static const FP32 *const winTables[WIN_NUM] = {WinHannTbl, WinBlackmanHarrisTbl, WinFlatTopTbl};
+
+/******************************************************************************
+ * WindowTableGet() - Returns the half table for 'win'
+ ******************************************************************************/
+const FP32 *WindowTableGet(WINDOW_T win){
+    return winTables[win];
+}
@@ -0,0 +1,19 @@
+/********************************************************************
+* Window.h - Header file for the window function tables
+*
+* agent, 10/18/2026
+********************************************************************/
+#ifndef WINDOW_H_
+#define WINDOW_H_
+
+#define WIN_HALF_SIZE ((DSP_FFT_SIZE/2) + 1)   //Entries in each half table
+
+typedef enum{WIN_HANN, WIN_BLACKMAN_HARRIS, WIN_FLAT_TOP, WIN_NUM} WINDOW_T;
+
+/******************************************************************************
+ * WindowTableGet() - Returns the flash table for 'win'. Holds w[0..N/2], the
+ *  second half of the frame uses w[N-n].
+ ******************************************************************************/
+const FP32 *WindowTableGet(WINDOW_T win);
+
+#endif
@@ -14,6 +14,7 @@
 * 01/14/2013 TDM Modified for K70 custom tower board.
 * 02/12/2013 TDM Modified to run under MicroC/OS-III
 * 01/18/2018 Changed to replace includes.h TDM
+* 10/18/2026 Register access moved to Hal.h
 *********************************************************************
 * Header Files - Dependencies
 ********************************************************************/
@@ -21,6 +22,7 @@
 #include "app_cfg.h"
 #include "os.h"
 #include "uCOSKey.h"
+#include "Hal.h"
 #include "k65TWR_GPIO.h"
 /********************************************************************
 * Module Defines
@@ -30,9 +32,7 @@
 *  ROW1->PTC7, ROW2->PTC8, ROW3->PTC9, ROW4->PTC10
 ********************************************************************/
 typedef enum{KEY_OFF,KEY_EDGE,KEY_VERF} KEYSTATES;
-#define KEY_PORT_OUT   GPIOC_PDOR
-#define KEY_PORT_DIR   GPIOC_PDDR
-#define KEY_PORT_IN	   GPIOC_PDIR
+#define KEY_PORT       HAL_PORTC
 #define COLS_MASK 0x00000078
 #define ROWS_MASK 0x00000780
 #define DC1 (INT8U)0x11     /*ASCII control code for the A button */
@@ -82,16 +82,16 @@ void KeyInit(void){
 
     OS_ERR os_err;
 	/* Key port init */
-    SIM_SCGC5 |= SIM_SCGC5_PORTC_MASK;              /* Enable clock gate for PORTC */
-    PORTC_PCR3=PORT_PCR_MUX(1)|PORT_PCR_PS_MASK|PORT_PCR_PE_MASK;
-    PORTC_PCR4=PORT_PCR_MUX(1)|PORT_PCR_PS_MASK|PORT_PCR_PE_MASK;
-    PORTC_PCR5=PORT_PCR_MUX(1)|PORT_PCR_PS_MASK|PORT_PCR_PE_MASK;
-    PORTC_PCR6=PORT_PCR_MUX(1)|PORT_PCR_PS_MASK|PORT_PCR_PE_MASK;
-	PORTC_PCR7=PORT_PCR_MUX(1);
-	PORTC_PCR8=PORT_PCR_MUX(1);
-	PORTC_PCR9=PORT_PCR_MUX(1);
-	PORTC_PCR10=PORT_PCR_MUX(1);
-    KEY_PORT_OUT &= ~ROWS_MASK;            /* Preset all rows to zero    */
+    HalGateSet(HAL_SCGC5, SIM_SCGC5_PORTC_MASK);    /* Enable clock gate for PORTC */
+    HalPinCfgSet(KEY_PORT, 3, PORT_PCR_MUX(1)|PORT_PCR_PS_MASK|PORT_PCR_PE_MASK);
+    HalPinCfgSet(KEY_PORT, 4, PORT_PCR_MUX(1)|PORT_PCR_PS_MASK|PORT_PCR_PE_MASK);
+    HalPinCfgSet(KEY_PORT, 5, PORT_PCR_MUX(1)|PORT_PCR_PS_MASK|PORT_PCR_PE_MASK);
+    HalPinCfgSet(KEY_PORT, 6, PORT_PCR_MUX(1)|PORT_PCR_PS_MASK|PORT_PCR_PE_MASK);
+	HalPinCfgSet(KEY_PORT, 7, PORT_PCR_MUX(1));
+	HalPinCfgSet(KEY_PORT, 8, PORT_PCR_MUX(1));
+	HalPinCfgSet(KEY_PORT, 9, PORT_PCR_MUX(1));
+	HalPinCfgSet(KEY_PORT, 10, PORT_PCR_MUX(1));
+    HalGpioOutSet(KEY_PORT, HalGpioOutGet(KEY_PORT) & ~ROWS_MASK);  /* Preset all rows to zero    */
     // Initialize the Key Buffer and semaphore
     keyBuffer.buffer = 0x00;           /* Init KeyBuffer      */
     OSSemCreate(&(keyBuffer.flag),"Key Semaphore",0,&os_err);
@@ -193,11 +193,11 @@ static INT8U keyScan(void) {
     rbit = 0x00000080;
     roff = 0x00;
     while(rbit != 0){ /* Until all rows are scanned */
-        KEY_PORT_OUT &= ~ROWS_MASK;
-        KEY_PORT_DIR = (KEY_PORT_DIR & ~ROWS_MASK)|rbit;    /* Pull row low */
+        HalGpioOutSet(KEY_PORT, HalGpioOutGet(KEY_PORT) & ~ROWS_MASK);
+        HalGpioDirSet(KEY_PORT, (HalGpioDirGet(KEY_PORT) & ~ROWS_MASK)|rbit);    /* Pull row low */
         keyDly();	// wait for direction and col inputs to settle
-        kcode = (INT8U)(((~KEY_PORT_IN) & COLS_MASK)>>3);  /*Read columns */
-        KEY_PORT_DIR = (KEY_PORT_DIR &~ROWS_MASK); 
+        kcode = (INT8U)(((~HalGpioInGet(KEY_PORT)) & COLS_MASK)>>3);  /*Read columns */
+        HalGpioDirSet(KEY_PORT, (HalGpioDirGet(KEY_PORT) &~ROWS_MASK)); 
         if(kcode != 0){        /* generate key code if key pressed */
             kcode = roff + ColTable[kcode];
             break;